@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+
+using Clock = std::chrono::steady_clock;
+
+// Describes a single benchmark case, its parameters end up as fields in the output
+struct Case
+{
+	std::string                                      Suite;
+	std::string                                      Name;
+	std::vector<std::pair<std::string, std::string>> Params;
+
+	Case(const std::string & aSuite, const std::string & aName)
+	    : Suite(aSuite)
+	    , Name(aName)
+	{
+	}
+
+	Case & Param(const std::string & aKey, const std::string & aValue)
+	{
+		Params.emplace_back(aKey, aValue);
+		return *this;
+	}
+
+	Case & Param(const std::string & aKey, long long aValue)
+	{
+		return Param(aKey, std::to_string(aValue));
+	}
+};
+
+struct Result
+{
+	unsigned      Threads    = 1;
+	bool          Contended  = false;
+	std::uint64_t Operations = 0;
+	double        Seconds    = 0;
+	double        MeanNs     = 0; // Per operation, measured over batches of operations
+	bool          Sampled    = true; // Whether the percentiles below were measured, they are left out otherwise
+	double        P50Ns      = 0;    // Latency of single operations
+	double        P99Ns      = 0;
+	double        MaxNs      = 0;
+
+	// Extra fields, for benchmarks that measure something other than the time per operation
+	std::vector<std::pair<std::string, double>> Extra;
+};
+
+struct Options
+{
+	std::string Filter;          // Only run cases of which "suite/name" contains this
+	bool        Quick   = false; // Fewer samples and smaller sizes, for smoke testing
+	bool        Text    = false; // Human readable output instead of JSON lines
+	FILE *      Output  = stdout;
+	unsigned    Samples = 200;
+	double      Budget  = 0.5; // Seconds per case
+};
+
+class Runner
+{
+public:
+	explicit Runner(const Options & aOptions)
+	    : Settings(aOptions)
+	{
+	}
+
+	const Options & GetOptions() const
+	{
+		return Settings;
+	}
+
+	bool Enabled(const Case & aCase) const
+	{
+		return (aCase.Suite + "/" + aCase.Name).find(Settings.Filter) != std::string::npos;
+	}
+
+	// Runs the operation on the given amount of threads. aMakeOperation(thread) is called on every thread before the
+	// measurement starts, and returns a callable that performs a single operation. Every sample times a batch of
+	// operations for the mean, followed by a few single operations for the latency percentiles.
+	template <typename MakeOperation>
+	void Run(const Case & aCase, unsigned aThreads, bool aContended, MakeOperation aMakeOperation)
+	{
+		if (!Enabled(aCase))
+			return;
+
+		std::vector<std::vector<double>> Samples(aThreads);
+		std::vector<std::vector<double>> Latencies(aThreads);
+		std::vector<std::uint64_t>       Operations(aThreads, 0);
+		std::atomic<unsigned>            ReadyCount(0);
+		std::atomic<bool>                Go(false);
+		Clock::time_point                Start;
+		std::vector<Clock::time_point>   Ends(aThreads);
+
+		auto Body = [&](unsigned aThread) {
+			auto Operation = aMakeOperation(aThread);
+
+			// Find a batch size that takes long enough to be measured accurately
+			std::uint64_t Batch = 1;
+			for (;;)
+			{
+				const Clock::time_point Before = Clock::now();
+				for (std::uint64_t i = 0; i < Batch; i++)
+					Operation();
+				if (Clock::now() - Before > std::chrono::microseconds(20) || Batch >= (1u << 20))
+					break;
+				Batch *= 2;
+			}
+
+			if (++ReadyCount == aThreads)
+			{ // Last thread to be ready starts the measurement
+				Start = Clock::now();
+				Go    = true;
+			}
+			while (!Go)
+				std::this_thread::yield();
+
+			const Clock::time_point Deadline =
+			    Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(Settings.Budget));
+			for (unsigned Sample = 0; Sample < Settings.Samples; Sample++)
+			{
+				const Clock::time_point Before = Clock::now();
+				for (std::uint64_t i = 0; i < Batch; i++)
+					Operation();
+				const Clock::time_point After = Clock::now();
+
+				Samples[aThread].push_back(std::chrono::duration<double, std::nano>(After - Before).count() / Batch);
+				Operations[aThread] += Batch;
+
+				for (unsigned Single = 0; Single < SinglesPerSample; Single++)
+				{
+					const Clock::time_point Begin = Clock::now();
+					Operation();
+					const double Nanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - Begin).count();
+					Latencies[aThread].push_back(std::max(0.0, Nanoseconds - ClockOverhead));
+				}
+				Operations[aThread] += SinglesPerSample;
+
+				if (Sample >= 10 && Clock::now() > Deadline)
+					break;
+			}
+			Ends[aThread] = Clock::now();
+		};
+
+		std::vector<std::thread> Threads;
+		for (unsigned Thread = 1; Thread < aThreads; Thread++)
+			Threads.emplace_back(Body, Thread);
+
+		// The calling thread takes part as thread 0
+		Body(0);
+		for (std::thread & Thread : Threads)
+			Thread.join();
+
+		std::vector<double> All;
+		std::vector<double> Singles;
+		Result              result;
+		result.Threads   = aThreads;
+		result.Contended = aContended;
+		for (unsigned Thread = 0; Thread < aThreads; Thread++)
+		{
+			All.insert(All.end(), Samples[Thread].begin(), Samples[Thread].end());
+			Singles.insert(Singles.end(), Latencies[Thread].begin(), Latencies[Thread].end());
+			result.Operations += Operations[Thread];
+			result.Seconds = std::max(result.Seconds, std::chrono::duration<double>(Ends[Thread] - Start).count());
+		}
+
+		double Total = 0;
+		for (unsigned Thread = 0; Thread < aThreads; Thread++)
+			for (double Sample : Samples[Thread])
+				Total += Sample;
+
+		std::sort(Singles.begin(), Singles.end());
+		result.MeanNs = Total / All.size();
+		result.P50Ns  = Percentile(Singles, 0.50);
+		result.P99Ns  = Percentile(Singles, 0.99);
+		result.MaxNs  = Singles.back();
+		Report(aCase, result);
+	}
+
+	void Report(const Case & aCase, const Result & aResult)
+	{ // Writes one line per case
+		if (Settings.Text)
+		{
+			std::string Name = aCase.Suite + "/" + aCase.Name;
+			for (const auto & Param : aCase.Params)
+				Name += " " + Param.first + "=" + Param.second;
+			std::fprintf(Settings.Output, "%-64s threads=%u%s mean=%.1fns", Name.c_str(), aResult.Threads,
+			             aResult.Contended ? " contended" : "", aResult.MeanNs);
+			if (aResult.Sampled)
+				std::fprintf(Settings.Output, " p50=%.1fns p99=%.1fns", aResult.P50Ns, aResult.P99Ns);
+			std::fprintf(Settings.Output, " ops/s=%.3g", OperationsPerSecond(aResult));
+			for (const auto & Field : aResult.Extra)
+				std::fprintf(Settings.Output, " %s=%.3g", Field.first.c_str(), Field.second);
+			std::fprintf(Settings.Output, "\n");
+		}
+		else
+		{
+			std::fprintf(Settings.Output, "{\"suite\":\"%s\",\"name\":\"%s\"", aCase.Suite.c_str(), aCase.Name.c_str());
+			for (const auto & Param : aCase.Params)
+				std::fprintf(Settings.Output, ",\"%s\":\"%s\"", Param.first.c_str(), Param.second.c_str());
+			std::fprintf(Settings.Output,
+			             ",\"threads\":%u,\"contended\":%s,\"operations\":%llu,\"seconds\":%.6f,\"ops_per_sec\":%.1f,"
+			             "\"mean_ns\":%.2f",
+			             aResult.Threads, aResult.Contended ? "true" : "false",
+			             static_cast<unsigned long long>(aResult.Operations), aResult.Seconds,
+			             OperationsPerSecond(aResult), aResult.MeanNs);
+			if (aResult.Sampled)
+				std::fprintf(Settings.Output, ",\"p50_ns\":%.2f,\"p99_ns\":%.2f,\"max_ns\":%.2f", aResult.P50Ns,
+				             aResult.P99Ns, aResult.MaxNs);
+			for (const auto & Field : aResult.Extra)
+				std::fprintf(Settings.Output, ",\"%s\":%.3f", Field.first.c_str(), Field.second);
+			std::fprintf(Settings.Output, "}\n");
+		}
+		std::fflush(Settings.Output);
+	}
+
+	static double Percentile(const std::vector<double> & aSorted, double aFraction)
+	{
+		if (aSorted.empty())
+			return 0;
+		return aSorted[static_cast<std::size_t>(aFraction * (aSorted.size() - 1) + 0.5)];
+	}
+
+private:
+	static constexpr unsigned SinglesPerSample = 16;
+
+	static double MeasureClockOverhead()
+	{ // Reading the clock is part of every single operation that gets timed, so it is subtracted
+		double Lowest = 1e9;
+		for (int i = 0; i < 1000; i++)
+		{
+			const Clock::time_point Begin = Clock::now();
+			Lowest = std::min(Lowest, std::chrono::duration<double, std::nano>(Clock::now() - Begin).count());
+		}
+		return Lowest;
+	}
+
+	static double OperationsPerSecond(const Result & aResult)
+	{
+		return aResult.Seconds > 0 ? aResult.Operations / aResult.Seconds : 0;
+	}
+
+private:
+	Options Settings;
+	double  ClockOverhead = MeasureClockOverhead();
+};
+
+// Payload of a given size, passed by value like event arguments are
+template <std::size_t Size>
+struct Payload
+{
+	unsigned char Bytes[Size];
+};
+
+// Keeps the compiler from optimising a value away
+template <typename T>
+inline void DoNotOptimize(const T & aValue)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(aValue) : "memory");
+#else
+	static volatile const void * Sink;
+	Sink = &aValue;
+#endif
+}
+
+void RegisterEventBenchmarks(Runner & aRunner);
+void RegisterEventLogBenchmarks(Runner & aRunner);
+void RegisterEventQueueBenchmarks(Runner & aRunner);
+void RegisterPipelineBenchmarks(Runner & aRunner);
+void RegisterPublisherBenchmarks(Runner & aRunner);
+void RegisterTimerBenchmarks(Runner & aRunner);
+void RegisterTimerServiceBenchmarks(Runner & aRunner);
+
+} // namespace bench
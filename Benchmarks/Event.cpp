@@ -0,0 +1,97 @@
+// Event::operator() by slot count, payload size and group count, and Connect + Disconnect with slots already
+// connected. The threaded cases either share one event (contended) or give every thread its own (uncontended).
+
+#include "Benchmark.hpp"
+
+#include <EventLib/Event.hpp>
+
+#include <memory>
+
+namespace bench
+{
+
+namespace
+{
+
+template <std::size_t Size>
+using _Event = el::Event<void(Payload<Size>)>;
+
+template <std::size_t Size>
+std::shared_ptr<_Event<Size>> MakeEvent(int aSlots, int aGroups)
+{ // Slots are spread over the groups, or left ungrouped when there are none
+	auto Evt = std::make_shared<_Event<Size>>();
+	for (int i = 0; i < aSlots; i++)
+	{
+		auto Slot = [](Payload<Size> aPayload) { DoNotOptimize(aPayload); };
+		if (aGroups > 0)
+			Evt->Connect(static_cast<unsigned>(i % aGroups), Slot);
+		else
+			Evt->Connect(Slot);
+	}
+	return Evt;
+}
+
+template <std::size_t Size>
+void Invoke(Runner & aRunner, int aSlots, int aGroups, unsigned aThreads, bool aContended)
+{
+	Case Info{ "Event", aGroups > 0 ? "InvokeGrouped" : "Invoke" };
+	Info.Param("slots", aSlots).Param("payload_bytes", static_cast<long long>(Size));
+	if (aGroups > 0)
+		Info.Param("groups", aGroups);
+
+	const auto Shared = MakeEvent<Size>(aSlots, aGroups);
+	aRunner.Run(Info, aThreads, aContended, [&](unsigned) {
+		const auto          Evt = aContended ? Shared : MakeEvent<Size>(aSlots, aGroups);
+		const Payload<Size> Arguments{};
+		return [Evt, Arguments]() { (*Evt)(Arguments); };
+	});
+}
+
+void ConnectDisconnect(Runner & aRunner, int aExisting, unsigned aThreads, bool aContended)
+{
+	Case Info{ "Event", "ConnectDisconnect" };
+	Info.Param("existing_slots", aExisting);
+
+	const auto Shared = MakeEvent<sizeof(int)>(aExisting, 0);
+	aRunner.Run(Info, aThreads, aContended, [&](unsigned) {
+		const auto Evt = aContended ? Shared : MakeEvent<sizeof(int)>(aExisting, 0);
+		return [Evt]() {
+			el::Connection connection = Evt->Connect([](Payload<sizeof(int)>) {});
+			Evt->Disconnect(connection);
+		};
+	});
+}
+
+} // namespace
+
+void RegisterEventBenchmarks(Runner & aRunner)
+{
+	const bool Quick = aRunner.GetOptions().Quick;
+
+	for (int Slots : Quick ? std::vector<int>{ 0, 8 } : std::vector<int>{ 0, 1, 8, 64 })
+	{
+		Invoke<sizeof(int)>(aRunner, Slots, 0, 1, false);
+		Invoke<64>(aRunner, Slots, 0, 1, false);
+		Invoke<1024>(aRunner, Slots, 0, 1, false);
+	}
+
+	for (int Groups : Quick ? std::vector<int>{ 4 } : std::vector<int>{ 4, 16 })
+		Invoke<sizeof(int)>(aRunner, 64, Groups, 1, false);
+
+	for (unsigned Threads : Quick ? std::vector<unsigned>{ 2 } : std::vector<unsigned>{ 2, 4 })
+	{
+		Invoke<sizeof(int)>(aRunner, 8, 0, Threads, true);
+		Invoke<sizeof(int)>(aRunner, 8, 0, Threads, false);
+	}
+
+	for (int Existing : Quick ? std::vector<int>{ 0, 64 } : std::vector<int>{ 0, 64, 1024 })
+		ConnectDisconnect(aRunner, Existing, 1, false);
+
+	for (unsigned Threads : Quick ? std::vector<unsigned>{ 2 } : std::vector<unsigned>{ 2, 4 })
+	{
+		ConnectDisconnect(aRunner, 64, Threads, true);
+		ConnectDisconnect(aRunner, 64, Threads, false);
+	}
+}
+
+} // namespace bench
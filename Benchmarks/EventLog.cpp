@@ -0,0 +1,91 @@
+// Recording publishes to an EventLog, and replaying a recorded stream of publishes at full speed, which is how a
+// recording is used as a load generator. Only built where the log is available.
+
+#include "Benchmark.hpp"
+
+#include <EventLib/EventLog.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <unistd.h>
+
+namespace bench
+{
+
+namespace
+{
+
+std::string LogPath(const char * aName)
+{
+	return "/tmp/EventLibBenchmark_" + std::to_string(getpid()) + "_" + aName + ".log";
+}
+
+} // namespace
+
+void RegisterEventLogBenchmarks(Runner & aRunner)
+{
+	const bool Quick = aRunner.GetOptions().Quick;
+
+	{
+		const std::string Path = LogPath("record");
+		auto Recorder          = std::make_shared<el::EventRecorder<int, Payload<64>>>(Path);
+		aRunner.Run(Case{ "EventLog", "Record" }.Param("payload_bytes", 64), 1, false, [&](unsigned) {
+			const Payload<64> Arguments{};
+			return [Recorder, Arguments]() { Recorder->Record(1, Arguments); };
+		});
+		Recorder.reset();
+		std::remove(Path.c_str());
+	}
+
+	// Replay a stream that publishes to random topics, as a whole, reported per replayed publish
+	const int         Records = Quick ? 10000 : 1000000;
+	const int         Topics  = 64;
+	const std::string Path    = LogPath("replay");
+	{
+		std::mt19937                       Random(42);
+		std::uniform_int_distribution<int> Topic(0, Topics - 1);
+		el::EventRecorder<int, Payload<64>> Recorder(Path);
+		for (int i = 0; i < Records; i++)
+			Recorder.Record(Topic(Random), Payload<64>{});
+	}
+
+	el::Publisher<int, Payload<64>> Pub;
+	for (int Topic = 0; Topic < Topics; Topic++)
+		Pub.Register(Topic, [](Payload<64> aPayload) { DoNotOptimize(aPayload); });
+
+	el::EventReplayer<int, Payload<64>> Replayer(Path);
+	Case                                Info{ "EventLog", "Replay" };
+	Info.Param("records", Records).Param("topics", Topics).Param("payload_bytes", 64);
+	if (aRunner.Enabled(Info))
+	{
+		const Clock::time_point Start = Clock::now();
+		Replayer.Replay(Pub);
+		const double Seconds = std::chrono::duration<double>(Clock::now() - Start).count();
+
+		Result result;
+		result.Operations = Replayer.GetRecordCount();
+		result.Seconds    = Seconds;
+		result.MeanNs     = Seconds * 1e9 / result.Operations;
+		result.Sampled    = false; // Single operations are not timed
+		aRunner.Report(Info, result);
+	}
+	std::remove(Path.c_str());
+}
+
+} // namespace bench
+
+#else
+
+namespace bench
+{
+
+void RegisterEventLogBenchmarks(Runner &)
+{
+}
+
+} // namespace bench
+
+#endif
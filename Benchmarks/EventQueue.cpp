@@ -0,0 +1,48 @@
+// Connecting a number of slots to an EventQueue and draining it, reported per drain.
+
+#include "Benchmark.hpp"
+
+#include <EventLib/EventQueue.hpp>
+
+#include <memory>
+
+namespace bench
+{
+
+namespace
+{
+
+void ConnectAndDrain(Runner & aRunner, int aSlots, unsigned aThreads, bool aContended)
+{
+	Case Info{ "EventQueue", "ConnectAndDrain" };
+	Info.Param("slots", aSlots);
+
+	using _Queue      = el::EventQueue<void(int)>;
+	const auto Shared = std::make_shared<_Queue>();
+	aRunner.Run(Info, aThreads, aContended, [&](unsigned) {
+		const auto Queue = aContended ? Shared : std::make_shared<_Queue>();
+		return [Queue, aSlots]() {
+			for (int i = 0; i < aSlots; i++)
+				Queue->Connect([](int aValue) { DoNotOptimize(aValue); });
+			(*Queue)(1);
+		};
+	});
+}
+
+} // namespace
+
+void RegisterEventQueueBenchmarks(Runner & aRunner)
+{
+	const bool Quick = aRunner.GetOptions().Quick;
+
+	for (int Slots : Quick ? std::vector<int>{ 1, 8 } : std::vector<int>{ 1, 8, 64 })
+		ConnectAndDrain(aRunner, Slots, 1, false);
+
+	for (unsigned Threads : Quick ? std::vector<unsigned>{ 2 } : std::vector<unsigned>{ 2, 4 })
+	{
+		ConnectAndDrain(aRunner, 8, Threads, true);
+		ConnectAndDrain(aRunner, 8, Threads, false);
+	}
+}
+
+} // namespace bench
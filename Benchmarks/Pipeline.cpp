@@ -0,0 +1,81 @@
+// Passing a call through a number of map stages, either as a chain of events where every stage is a slot that calls
+// the next event, or as a pipeline whose stages are fused into a single slot.
+
+#include "Benchmark.hpp"
+
+#include <EventLib/Pipeline.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace bench
+{
+
+namespace
+{
+
+using _Event = el::Event<void(int)>;
+
+struct Events
+{ // The first event is the source, the last one has the only real slot
+	std::vector<std::unique_ptr<_Event>> Chain;
+
+	explicit Events(int aCount)
+	{
+		for (int i = 0; i < aCount; i++)
+			Chain.emplace_back(new _Event());
+		Chain.back()->Connect([](int aValue) { DoNotOptimize(aValue); });
+	}
+};
+
+std::shared_ptr<Events> MakeChained(int aStages)
+{
+	auto Evts = std::make_shared<Events>(aStages + 1);
+	for (int i = 0; i < aStages; i++)
+	{
+		_Event * Next = Evts->Chain[i + 1].get();
+		Evts->Chain[i]->Connect([Next](int aValue) { (*Next)(aValue + 1); });
+	}
+	return Evts;
+}
+
+std::shared_ptr<Events> MakeFused(int aStages)
+{ // The stages of a pipeline are part of its type, so the measured stage counts are written out
+	auto       Evts   = std::make_shared<Events>(2);
+	_Event &   Source = *Evts->Chain[0];
+	_Event &   Target = *Evts->Chain[1];
+	const auto Step   = el::Map([](int aValue) { return aValue + 1; });
+	if (aStages == 1)
+		Source | Step | el::Sink(Target);
+	else if (aStages == 4)
+		Source | Step | Step | Step | Step | el::Sink(Target);
+	else
+		Source | Step | Step | Step | Step | Step | Step | Step | Step | el::Sink(Target);
+	return Evts;
+}
+
+void Invoke(Runner & aRunner, int aStages, bool aFused)
+{
+	Case Info{ "Pipeline", aFused ? "InvokeFused" : "InvokeChained" };
+	Info.Param("stages", aStages);
+
+	aRunner.Run(Info, 1, false, [&](unsigned) {
+		const auto Evts = aFused ? MakeFused(aStages) : MakeChained(aStages);
+		return [Evts]() { (*Evts->Chain[0])(1); };
+	});
+}
+
+} // namespace
+
+void RegisterPipelineBenchmarks(Runner & aRunner)
+{
+	const bool Quick = aRunner.GetOptions().Quick;
+
+	for (int Stages : Quick ? std::vector<int>{ 1, 4 } : std::vector<int>{ 1, 4, 8 })
+	{
+		Invoke(aRunner, Stages, false);
+		Invoke(aRunner, Stages, true);
+	}
+}
+
+} // namespace bench
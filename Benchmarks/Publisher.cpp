@@ -0,0 +1,86 @@
+// Publisher::Publish by topic count and slots per topic. Every operation publishes to the next topic, so the lookup
+// is not always served from the same bucket. EventBus::Publish is included for comparison, it has no lookup at all.
+
+#include "Benchmark.hpp"
+
+#include <EventLib/EventBus.hpp>
+#include <EventLib/Publisher.hpp>
+
+#include <memory>
+
+namespace bench
+{
+
+namespace
+{
+
+using _Publisher = el::Publisher<int, Payload<64>>;
+
+std::shared_ptr<_Publisher> MakePublisher(int aTopics, int aSlots)
+{
+	auto Pub = std::make_shared<_Publisher>();
+	for (int Topic = 0; Topic < aTopics; Topic++)
+		for (int i = 0; i < aSlots; i++)
+			Pub->Register(Topic, [](Payload<64> aPayload) { DoNotOptimize(aPayload); });
+	return Pub;
+}
+
+void Publish(Runner & aRunner, int aTopics, int aSlots, unsigned aThreads, bool aContended)
+{
+	Case Info{ "Publisher", "Publish" };
+	Info.Param("topics", aTopics).Param("slots_per_topic", aSlots).Param("payload_bytes", 64);
+
+	const auto Shared = MakePublisher(aTopics, aSlots);
+	aRunner.Run(Info, aThreads, aContended, [&](unsigned aThread) {
+		const auto        Pub = aContended ? Shared : MakePublisher(aTopics, aSlots);
+		const Payload<64> Arguments{};
+		int               Topic = static_cast<int>(aThread) % aTopics;
+		return [Pub, Arguments, Topic, aTopics]() mutable {
+			Pub->Publish(Topic, Arguments);
+			if (++Topic == aTopics)
+				Topic = 0;
+		};
+	});
+}
+
+template <int Topic>
+struct Message
+{
+	Payload<64> Data;
+};
+
+void BusPublish(Runner & aRunner, int aSlots)
+{
+	Case Info{ "EventBus", "Publish" };
+	Info.Param("types", 4).Param("slots_per_type", aSlots).Param("payload_bytes", 64);
+
+	using _Bus = el::EventBus<Message<0>, Message<1>, Message<2>, Message<3>>;
+	aRunner.Run(Info, 1, false, [&](unsigned) {
+		auto Bus = std::make_shared<_Bus>();
+		for (int i = 0; i < aSlots; i++)
+			Bus->Subscribe<Message<2>>([](const Message<2> & aMessage) { DoNotOptimize(aMessage); });
+		return [Bus]() { Bus->Publish(Message<2>{}); };
+	});
+}
+
+} // namespace
+
+void RegisterPublisherBenchmarks(Runner & aRunner)
+{
+	const bool Quick = aRunner.GetOptions().Quick;
+
+	for (int Topics : Quick ? std::vector<int>{ 1, 64 } : std::vector<int>{ 1, 64, 4096 })
+		for (int Slots : Quick ? std::vector<int>{ 1 } : std::vector<int>{ 1, 8 })
+			Publish(aRunner, Topics, Slots, 1, false);
+
+	for (int Slots : Quick ? std::vector<int>{ 1 } : std::vector<int>{ 1, 8 })
+		BusPublish(aRunner, Slots);
+
+	for (unsigned Threads : Quick ? std::vector<unsigned>{ 2 } : std::vector<unsigned>{ 2, 4 })
+	{
+		Publish(aRunner, 64, 1, Threads, true);
+		Publish(aRunner, 64, 1, Threads, false);
+	}
+}
+
+} // namespace bench
@@ -0,0 +1,87 @@
+// A single update of 1 ms for every timer manager, with looping timers that have intervals spread over a second. The
+// managers differ in how much of that work depends on the number of timers that are not due.
+
+#include "Benchmark.hpp"
+
+#include <EventLib/DeadlineTimerManager.hpp>
+#include <EventLib/Timer.hpp>
+#include <EventLib/TimerPool.hpp>
+#include <EventLib/TimerWheel.hpp>
+
+#include <chrono>
+#include <memory>
+#include <random>
+
+namespace bench
+{
+
+namespace
+{
+
+using Time = std::chrono::microseconds;
+
+std::vector<Time> MakeIntervals(int aCount)
+{ // Same intervals for every manager
+	std::mt19937                       Random(42);
+	std::uniform_int_distribution<int> Interval(1, 1000);
+	std::vector<Time>                  Intervals;
+	for (int i = 0; i < aCount; i++)
+		Intervals.push_back(std::chrono::milliseconds(Interval(Random)));
+	return Intervals;
+}
+
+template <typename MakeOperation>
+void Update(Runner & aRunner, const char * aManager, int aTimers, MakeOperation aMakeOperation)
+{
+	Case Info{ "Timer", "Update" };
+	Info.Param("manager", aManager).Param("timers", aTimers);
+	aRunner.Run(Info, 1, false, aMakeOperation);
+}
+
+} // namespace
+
+void RegisterTimerBenchmarks(Runner & aRunner)
+{
+	const bool Quick = aRunner.GetOptions().Quick;
+	const Time Step  = std::chrono::milliseconds(1);
+
+	for (int Timers : Quick ? std::vector<int>{ 1000 } : std::vector<int>{ 1000, 10000, 100000 })
+	{
+		const std::vector<Time> Intervals = MakeIntervals(Timers);
+
+		Update(aRunner, "TimerManager", Timers, [&](unsigned) {
+			auto Manager = std::make_shared<el::TimerManager<Time>>();
+			for (const Time & Interval : Intervals)
+				Manager->Create(Interval, true)->OnTrigger.Connect([]() {});
+			return [Manager, Step]() { Manager->UpdateTimers(Step); };
+		});
+
+		Update(aRunner, "TimerWheel", Timers, [&](unsigned) {
+			auto Manager = std::make_shared<el::TimerWheel<Time>>(Step);
+			for (const Time & Interval : Intervals)
+				Manager->Create(Interval, true)->OnTrigger.Connect([]() {});
+			return [Manager, Step]() { Manager->UpdateTimers(Step); };
+		});
+
+		Update(aRunner, "DeadlineTimerManager", Timers, [&](unsigned) {
+			using Clock  = std::chrono::steady_clock;
+			auto Manager = std::make_shared<el::DeadlineTimerManager<Clock>>();
+			for (const Time & Interval : Intervals)
+				Manager->Create(Interval, true)->OnTrigger.Connect([]() {});
+			Clock::time_point Now = Clock::now();
+			return [Manager, Step, Now]() mutable {
+				Now += Step;
+				DoNotOptimize(Manager->RunDue(Now));
+			};
+		});
+
+		Update(aRunner, "TimerPool", Timers, [&](unsigned) {
+			auto Manager = std::make_shared<el::TimerPool<Time>>();
+			for (const Time & Interval : Intervals)
+				Manager->Create(Interval, true, []() {});
+			return [Manager, Step]() { Manager->UpdateTimers(Step); };
+		});
+	}
+}
+
+} // namespace bench
@@ -0,0 +1,94 @@
+// Schedules callbacks with delays spread over a second on a TimerService, and reports how long scheduling took, how
+// late the callbacks ran, and how long it took until all of them had run. A thread-per-callback run with fewer
+// callbacks is included for comparison, as that is how TimerManager::CreateThreaded used to work.
+
+#include "Benchmark.hpp"
+
+#include <EventLib/TimerService.hpp>
+
+#include <functional>
+#include <random>
+
+namespace bench
+{
+
+namespace
+{
+
+double Microseconds(Clock::duration aDuration)
+{
+	return std::chrono::duration<double, std::micro>(aDuration).count();
+}
+
+template <typename ScheduleFunc>
+void Run(Runner & aRunner, const Case & aCase, std::size_t aCount, int aSpread, ScheduleFunc aSchedule)
+{
+	if (!aRunner.Enabled(aCase))
+		return;
+
+	std::mt19937                       Random(42);
+	std::uniform_int_distribution<int> Delay(0, aSpread);
+
+	std::vector<Clock::time_point> Deadlines(aCount);
+	std::vector<Clock::duration>   Lateness(aCount);
+	std::atomic<std::size_t>       Done(0);
+
+	const Clock::time_point Start = Clock::now();
+	for (std::size_t i = 0; i < aCount; i++)
+	{
+		const std::chrono::milliseconds Wait(Delay(Random));
+		Deadlines[i] = Clock::now() + Wait;
+		aSchedule(Wait, [&, i]() {
+			Lateness[i] = Clock::now() - Deadlines[i];
+			Done++;
+		});
+	}
+	const Clock::time_point Scheduled = Clock::now();
+
+	while (Done != aCount)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	const Clock::time_point End = Clock::now();
+
+	// Time per operation is the time it took to schedule a callback
+	std::vector<double> Late;
+	for (const Clock::duration & Duration : Lateness)
+		Late.push_back(Microseconds(Duration));
+	std::sort(Late.begin(), Late.end());
+
+	Result result;
+	result.Operations = aCount;
+	result.Seconds    = std::chrono::duration<double>(Scheduled - Start).count();
+	result.MeanNs     = Microseconds(Scheduled - Start) * 1000.0 / aCount;
+	result.Sampled    = false; // Single operations are not timed
+	result.Extra.emplace_back("total_ms", Microseconds(End - Start) / 1000.0);
+	result.Extra.emplace_back("lateness_p50_us", Runner::Percentile(Late, 0.50));
+	result.Extra.emplace_back("lateness_p99_us", Runner::Percentile(Late, 0.99));
+	result.Extra.emplace_back("lateness_max_us", Late.back());
+	aRunner.Report(aCase, result);
+}
+
+} // namespace
+
+void RegisterTimerServiceBenchmarks(Runner & aRunner)
+{
+	const bool        Quick  = aRunner.GetOptions().Quick;
+	const std::size_t Count  = Quick ? 10000 : 100000;
+	const int         Spread = Quick ? 100 : 1000;
+
+	for (std::size_t Workers : Quick ? std::vector<std::size_t>{ 1 } : std::vector<std::size_t>{ 1, 2, 4 })
+	{
+		el::TimerService Service(Workers);
+		Run(aRunner, Case{ "TimerService", "Schedule" }.Param("workers", static_cast<long long>(Workers)), Count, Spread,
+		    [&](std::chrono::milliseconds aWait, std::function<void()> aFunc) { Service.Schedule(aWait, aFunc); });
+	}
+
+	Run(aRunner, Case{ "TimerService", "ThreadPerCall" }, Quick ? 200 : 2000, Spread,
+	    [](std::chrono::milliseconds aWait, std::function<void()> aFunc) {
+		    std::thread([=]() {
+			    std::this_thread::sleep_for(aWait);
+			    aFunc();
+		    }).detach();
+	    });
+}
+
+} // namespace bench
@@ -0,0 +1,56 @@
+// Runs the EventLib benchmarks and writes one JSON object per case, so results of different runs can be compared.
+//
+// EventLibBenchmarks [--filter <text>] [--quick] [--text] [--output <file>]
+
+#include "Benchmark.hpp"
+
+#include <cstring>
+
+int main(int argc, char ** argv)
+{
+	bench::Options Settings;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+		{
+			Settings.Filter = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--quick") == 0)
+		{ // Just enough to see that everything runs
+			Settings.Quick   = true;
+			Settings.Samples = 20;
+			Settings.Budget  = 0.01;
+		}
+		else if (std::strcmp(argv[i], "--text") == 0)
+		{
+			Settings.Text = true;
+		}
+		else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+		{
+			Settings.Output = std::fopen(argv[++i], "w");
+			if (Settings.Output == nullptr)
+			{
+				std::fprintf(stderr, "Could not open %s for writing\n", argv[i]);
+				return 1;
+			}
+		}
+		else
+		{
+			std::fprintf(stderr, "Usage: %s [--filter <text>] [--quick] [--text] [--output <file>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	bench::Runner Runner(Settings);
+	bench::RegisterEventBenchmarks(Runner);
+	bench::RegisterEventQueueBenchmarks(Runner);
+	bench::RegisterEventLogBenchmarks(Runner);
+	bench::RegisterPipelineBenchmarks(Runner);
+	bench::RegisterPublisherBenchmarks(Runner);
+	bench::RegisterTimerBenchmarks(Runner);
+	bench::RegisterTimerServiceBenchmarks(Runner);
+
+	if (Settings.Output != stdout)
+		std::fclose(Settings.Output);
+	return 0;
+}
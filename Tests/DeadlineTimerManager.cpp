@@ -0,0 +1,155 @@
+#include "CppUnitTest.h"
+
+#include <EventLib/DeadlineTimerManager.hpp>
+#include <chrono>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace EventLibTest
+{
+
+struct ManualClock
+{ // Clock that only moves when told to
+	using duration   = std::chrono::milliseconds;
+	using rep        = duration::rep;
+	using period     = duration::period;
+	using time_point = std::chrono::time_point<ManualClock>;
+
+	static constexpr bool is_steady = true;
+
+	static time_point now()
+	{
+		return Now;
+	}
+
+	static time_point Now;
+};
+
+ManualClock::time_point ManualClock::Now;
+
+TEST_CLASS(DeadlineTimerManagerTest)
+{
+public:
+	TEST_METHOD(DeadlineTimerManagerNextDeadline)
+	{
+		using Milliseconds = std::chrono::milliseconds;
+		ManualClock::Now   = ManualClock::time_point();
+
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::DeadlineTimerManager<ManualClock> Manager;
+
+		Assert::IsTrue(Manager.NextDeadline() == ManualClock::time_point::max());
+
+		Manager.Create(Milliseconds(30))->OnTrigger.Connect(IncrementI);
+		Manager.Create(Milliseconds(10))->OnTrigger.Connect(IncrementI);
+
+		Assert::IsTrue(Manager.NextDeadline() == ManualClock::time_point(Milliseconds(10)));
+
+		Assert::AreEqual(Manager.RunDue(ManualClock::time_point(Milliseconds(9))), size_t(0));
+		Assert::AreEqual(Manager.RunDue(ManualClock::time_point(Milliseconds(10))), size_t(1));
+		Assert::AreEqual(i, 1); // i == 1
+
+		Assert::IsTrue(Manager.NextDeadline() == ManualClock::time_point(Milliseconds(30)));
+		Assert::AreEqual(Manager.Count(), size_t(1));
+	}
+
+	TEST_METHOD(DeadlineTimerManagerLoopingCatchUp)
+	{
+		using Milliseconds = std::chrono::milliseconds;
+		ManualClock::Now   = ManualClock::time_point();
+
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::DeadlineTimerManager<ManualClock> Manager;
+		Manager.Create(Milliseconds(10), true)->OnTrigger.Connect(IncrementI);
+
+		// Late by a few milliseconds, the next deadline is still on the original schedule
+		Assert::AreEqual(Manager.RunDue(ManualClock::time_point(Milliseconds(13))), size_t(1));
+		Assert::IsTrue(Manager.NextDeadline() == ManualClock::time_point(Milliseconds(20)));
+
+		// Three intervals passed, so it fires three times
+		Assert::AreEqual(Manager.RunDue(ManualClock::time_point(Milliseconds(45))), size_t(3));
+		Assert::AreEqual(i, 4); // i == 4
+		Assert::IsTrue(Manager.NextDeadline() == ManualClock::time_point(Milliseconds(50)));
+	}
+
+	TEST_METHOD(DeadlineTimerManagerPause)
+	{
+		using Milliseconds = std::chrono::milliseconds;
+		ManualClock::Now   = ManualClock::time_point();
+
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::DeadlineTimerManager<ManualClock> Manager;
+		auto Timer = Manager.Create(Milliseconds(10));
+		Timer->OnTrigger.Connect(IncrementI);
+
+		ManualClock::Now = ManualClock::time_point(Milliseconds(4));
+		Timer->Pause();
+
+		Assert::IsTrue(Manager.NextDeadline() == ManualClock::time_point::max());
+		Assert::IsTrue(Timer->GetTimeLeft() == Milliseconds(6));
+
+		ManualClock::Now = ManualClock::time_point(Milliseconds(100));
+		Timer->Resume();
+
+		Assert::IsTrue(Manager.NextDeadline() == ManualClock::time_point(Milliseconds(106)));
+		Manager.RunDue(ManualClock::time_point(Milliseconds(106)));
+
+		Assert::AreEqual(i, 1); // i == 1
+		Assert::AreEqual(Manager.Count(), size_t(0));
+	}
+
+	TEST_METHOD(DeadlineTimerManagerPauseWhileFiring)
+	{
+		using Milliseconds = std::chrono::milliseconds;
+		ManualClock::Now   = ManualClock::time_point();
+
+		int i = 0;
+
+		el::DeadlineTimerManager<ManualClock> Manager;
+		auto Timer = Manager.Create(Milliseconds(10), true);
+		Timer->OnTrigger.Connect([&]() {
+			i++;
+			Timer->Pause();
+		});
+
+		Assert::AreEqual(Manager.RunDue(ManualClock::time_point(Milliseconds(10))), size_t(1));
+		Assert::IsTrue(Timer->GetTimeLeft() == Milliseconds(10));
+
+		// Resuming starts a full interval, like it does for TimerManager
+		ManualClock::Now = ManualClock::time_point(Milliseconds(50));
+		Timer->Resume();
+
+		Assert::IsTrue(Manager.NextDeadline() == ManualClock::time_point(Milliseconds(60)));
+		Assert::AreEqual(Manager.RunDue(ManualClock::time_point(Milliseconds(50))), size_t(0));
+		Assert::AreEqual(i, 1); // i == 1
+	}
+
+	TEST_METHOD(DeadlineTimerManagerDelete)
+	{
+		using Milliseconds = std::chrono::milliseconds;
+		ManualClock::Now   = ManualClock::time_point();
+
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::DeadlineTimerManager<ManualClock> Manager;
+		auto First  = Manager.Create(Milliseconds(10));
+		auto Second = Manager.Create(Milliseconds(10));
+		First->OnTrigger.Connect(IncrementI);
+		First->OnTrigger.Connect([&Second]() { Second->Delete(); });
+		Second->OnTrigger.Connect(IncrementI);
+
+		Manager.RunDue(ManualClock::time_point(Milliseconds(10)));
+
+		Assert::AreEqual(i, 1); // Second was deleted before it could fire
+		Assert::AreEqual(Manager.Count(), size_t(0));
+	}
+};
+
+} // namespace EventLibTest
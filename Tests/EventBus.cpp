@@ -0,0 +1,90 @@
+#include "CppUnitTest.h"
+
+#include <EventLib/EventBus.hpp>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace EventLibTest
+{
+
+namespace
+{
+
+struct Moved
+{
+	int X;
+	int Y;
+};
+
+struct Clicked
+{
+	int Button;
+};
+
+} // namespace
+
+TEST_CLASS(EventBusTest)
+{
+public:
+	TEST_METHOD(EventBusTypeId)
+	{
+		using Bus = el::EventBus<Moved, Clicked, std::string>;
+		static_assert(Bus::TypeId<Moved>() == 0, "TypeId is the position in the list");
+		static_assert(Bus::TypeId<std::string>() == 2, "TypeId is the position in the list");
+		Assert::AreEqual(Bus::TypeId<Clicked>(), std::size_t(1));
+	}
+
+	TEST_METHOD(EventBusPublish)
+	{
+		el::EventBus<Moved, Clicked, std::string> Bus;
+
+		int         Distance = 0;
+		int         Clicks   = 0;
+		std::string Text;
+		Bus.Subscribe<Moved>([&Distance](const Moved & aMoved) { Distance += aMoved.X + aMoved.Y; });
+		Bus.Subscribe<Clicked>([&Clicks](const Clicked &) { Clicks++; });
+		Bus.Subscribe<std::string>([&Text](const std::string & aText) { Text += aText; });
+
+		Bus.Publish(Moved{ 1, 2 });
+		Bus.Publish(Clicked{ 0 });
+		Bus(Moved{ 3, 4 });
+		Bus.Publish(std::string("bus"));
+
+		Assert::AreEqual(Distance, 10); // Distance == 10
+		Assert::AreEqual(Clicks, 1);    // Clicks == 1
+		Assert::AreEqual(Text, std::string("bus"));
+	}
+
+	TEST_METHOD(EventBusUnsubscribe)
+	{
+		el::EventBus<Moved, Clicked> Bus;
+
+		int  i          = 0;
+		auto connection = Bus.Subscribe<Clicked>([&i](const Clicked &) { i++; });
+		Bus.Subscribe<Clicked>([&i](const Clicked &) { i += 10; });
+		Bus.Publish(Clicked{ 0 });
+
+		Assert::AreEqual(i, 11); // i == 11
+
+		Bus.Unsubscribe<Clicked>(connection);
+		Bus.Publish(Clicked{ 0 });
+
+		Assert::AreEqual(i, 21); // i == 21
+	}
+
+	TEST_METHOD(EventBusLocation)
+	{
+		el::EventBus<Clicked> Bus;
+
+		std::string Order;
+		Bus.Subscribe<Clicked>([&Order](const Clicked &) { Order += "b"; });
+		Bus.Subscribe<Clicked>([&Order](const Clicked &) { Order += "a"; }, el::Front);
+		Bus.GetEvent<Clicked>().Connect(1u, [&Order](const Clicked &) { Order += "g"; });
+		Bus.Publish(Clicked{ 0 });
+
+		Assert::AreEqual(Order, std::string("agb"));
+	}
+};
+
+} // namespace EventLibTest
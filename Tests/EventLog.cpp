@@ -0,0 +1,162 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#include "CppUnitTest.h"
+
+#include <EventLib/EventLog.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace EventLibTest
+{
+
+namespace
+{
+
+std::string LogPath(const char * aName)
+{
+	return "/tmp/EventLibTest_" + std::to_string(getpid()) + "_" + aName + ".log";
+}
+
+} // namespace
+
+TEST_CLASS(EventLogTest)
+{
+public:
+	TEST_METHOD(EventLogEvent)
+	{
+		const std::string Path = LogPath("event");
+
+		el::Event<void(int, double)> Signal;
+		{
+			el::EventRecorder<int, double> Recorder(Path);
+			Recorder.Attach(Signal);
+			Signal(1, 0.5);
+			Signal(2, 1.5);
+			Assert::AreEqual(Recorder.GetRecordCount(), std::uint64_t(2));
+		}
+		Signal(3, 2.5); // The recorder disconnected when it was destroyed
+
+		int    Sum   = 0;
+		double Total = 0;
+		el::Event<void(int, double)> Replayed;
+		Replayed.Connect([&](int aValue, double aReal) {
+			Sum += aValue;
+			Total += aReal;
+		});
+
+		el::EventReplayer<int, double> Replayer(Path);
+		Assert::AreEqual(Replayer.GetRecordCount(), std::size_t(2));
+		Assert::AreEqual(Replayer.Replay(Replayed), std::size_t(2));
+		Assert::AreEqual(Sum, 3);     // Sum == 3
+		Assert::AreEqual(Total, 2.0); // Total == 2.0
+
+		// Replaying again gives the same result
+		Replayer.Replay(Replayed);
+		Assert::AreEqual(Sum, 6); // Sum == 6
+		std::remove(Path.c_str());
+	}
+
+	TEST_METHOD(EventLogPublisher)
+	{
+		const std::string Path = LogPath("publisher");
+
+		el::Publisher<int, int> Pub;
+		{
+			el::EventRecorder<int, int> Recorder(Path);
+			Recorder.Attach(Pub, 1);
+			Pub.Publish(1, 10);
+			Pub.Publish(2, 20); // Not recorded
+			Pub.Publish(1, 30);
+		}
+
+		int                     i = 0;
+		el::Publisher<int, int> Target;
+		Target.Register(1, [&i](int aValue) { i += aValue; });
+
+		el::EventReplayer<int, int> Replayer(Path);
+		Assert::AreEqual(Replayer.Replay(Target), std::size_t(2));
+		Assert::AreEqual(i, 40); // i == 40
+		std::remove(Path.c_str());
+	}
+
+	TEST_METHOD(EventLogOriginalSpeed)
+	{
+		const std::string Path = LogPath("speed");
+		{
+			el::EventRecorder<int> Recorder(Path);
+			Recorder.Record(1);
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			Recorder(2);
+		}
+
+		el::EventReplayer<int> Replayer(Path);
+		Assert::IsTrue(Replayer.GetDuration() >= std::chrono::milliseconds(20));
+
+		std::vector<int> Values;
+		const auto       Start = std::chrono::steady_clock::now();
+		Replayer.Replay([&Values](int aValue) { Values.push_back(aValue); }, 1.0);
+		Assert::IsTrue(std::chrono::steady_clock::now() - Start >= std::chrono::milliseconds(20));
+		Assert::AreEqual(Values.size(), std::size_t(2));
+		Assert::AreEqual(Values[1], 2); // In recorded order
+		std::remove(Path.c_str());
+	}
+
+	TEST_METHOD(EventLogThreads)
+	{ // Spans more than one chunk, from multiple threads
+		const std::string Path = LogPath("threads");
+		{
+			el::EventRecorder<int>   Recorder(Path);
+			std::vector<std::thread> Threads;
+			for (int t = 0; t < 4; t++)
+			{
+				Threads.emplace_back([&Recorder]() {
+					for (int i = 0; i < 50000; i++)
+						Recorder.Record(1);
+				});
+			}
+			for (std::thread & Thread : Threads)
+				Thread.join();
+
+			Assert::IsTrue(Recorder.Close());
+			Assert::IsTrue(Recorder.Close()); // Closing again does nothing
+		}
+
+		long long              Sum = 0;
+		el::EventReplayer<int> Replayer(Path);
+		Replayer.Replay([&Sum](int aValue) { Sum += aValue; });
+		Assert::AreEqual(Replayer.GetRecordCount(), std::size_t(200000));
+		Assert::AreEqual(Sum, 200000LL);
+		std::remove(Path.c_str());
+	}
+
+	TEST_METHOD(EventLogTypeMismatch)
+	{
+		const std::string Path = LogPath("mismatch");
+		{
+			el::EventRecorder<int> Recorder(Path);
+			Recorder.Record(1);
+		}
+
+		bool Thrown = false;
+		try
+		{
+			el::EventReplayer<double, double> Replayer(Path);
+		}
+		catch (const std::system_error &)
+		{
+			Thrown = true;
+		}
+		Assert::IsTrue(Thrown);
+		std::remove(Path.c_str());
+	}
+};
+
+} // namespace EventLibTest
+
+#endif // defined(__unix__) || defined(__APPLE__)
@@ -0,0 +1,174 @@
+#include "CppUnitTest.h"
+
+#include <EventLib/Event.hpp>
+#include <EventLib/Publisher.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+#ifdef EL_ENABLE_INSTRUMENTATION
+
+namespace EventLibTest
+{
+
+TEST_CLASS(InstrumentationTest)
+{
+public:
+	TEST_METHOD(InstrumentationCounters)
+	{
+		el::Event<void(int)> Signal;
+		auto                 First  = Signal.Connect([](int) {});
+		auto                 Second = Signal.Connect([](int) {});
+		Signal.Connect(1u, [](int) {});
+
+		Signal(0);
+		Second.SetBlocking(true);
+		Signal(0);
+		First.Disconnect();
+		Signal(0);
+
+		const el::DispatchStats Stats = Signal.GetInstrumentation().GetStats();
+		Assert::AreEqual(Stats.Dispatches, std::uint64_t(3));
+		Assert::AreEqual(Stats.SlotsInvoked, std::uint64_t(6)); // 3 + 2 + 1
+		Assert::AreEqual(Stats.SlotsSkipped, std::uint64_t(3)); // 0 + 1 + 2
+
+		const std::vector<el::SlotStats> Slots = Signal.GetInstrumentation().GetSlotStats();
+		Assert::AreEqual(Slots.size(), std::size_t(3));
+		Assert::IsTrue(Slots[0].connection.SharesSlotWith(First));
+		Assert::AreEqual(Slots[0].Calls, std::uint64_t(2));
+		Assert::AreEqual(Slots[1].Calls, std::uint64_t(1));
+		Assert::AreEqual(Slots[2].Calls, std::uint64_t(3));
+
+		Signal.GetInstrumentation().Reset();
+		Assert::AreEqual(Signal.GetInstrumentation().GetStats().Dispatches, std::uint64_t(0));
+		Assert::AreEqual(Signal.GetInstrumentation().GetSlotStats()[2].Calls, std::uint64_t(0));
+	}
+
+	TEST_METHOD(InstrumentationRemovedSlots)
+	{
+		el::Event<void()> Signal;
+		auto              connection = Signal.Connect([]() {});
+		Signal.Connect([]() {});
+
+		Signal.Disconnect(connection);
+		const std::vector<el::SlotStats> Slots = Signal.GetInstrumentation().GetSlotStats();
+		Assert::AreEqual(Slots.size(), std::size_t(1));
+		Assert::AreEqual(Slots[0].Id, std::uint64_t(1));
+
+		// The new slot takes over the counters of the removed one, and starts from zero
+		Signal();
+		Signal.Connect([]() {});
+		const std::vector<el::SlotStats> Reused = Signal.GetInstrumentation().GetSlotStats();
+		Assert::AreEqual(Reused.size(), std::size_t(2));
+		Assert::AreEqual(Reused[0].Id, std::uint64_t(2));
+		Assert::AreEqual(Reused[0].Calls, std::uint64_t(0));
+		Assert::AreEqual(Reused[1].Calls, std::uint64_t(1));
+	}
+
+	TEST_METHOD(InstrumentationCopiedEvent)
+	{
+		el::Event<void()> Original;
+		Original.Connect([]() {});
+		Original.Connect(1u, []() {});
+
+		el::Event<void()> Copy(Original);
+		Copy.Connect([]() {}); // Does not share counters with a copied slot
+		Copy();
+
+		const std::vector<el::SlotStats> Slots = Copy.GetInstrumentation().GetSlotStats();
+		Assert::AreEqual(Slots.size(), std::size_t(3));
+		for (const el::SlotStats & Slot : Slots)
+			Assert::AreEqual(Slot.Calls, std::uint64_t(1));
+
+		// The original only counts its own dispatches
+		Assert::AreEqual(Original.GetInstrumentation().GetSlotStats()[0].Calls, std::uint64_t(0));
+	}
+
+	TEST_METHOD(InstrumentationSlotTimedAlone)
+	{
+		int                  Reported = 0;
+		el::Event<void(int)> Signal;
+		auto                 Cheap = Signal.Connect([](int) {});
+		Signal.Connect([](int aSleep) { std::this_thread::sleep_for(std::chrono::milliseconds(aSleep)); });
+
+		Signal.GetInstrumentation().SetSlowSlotHandler(
+		    std::chrono::milliseconds(5),
+		    [&](const el::SlotStats & aSlot, std::chrono::nanoseconds) {
+			    Reported++;
+			    Assert::IsFalse(aSlot.connection.SharesSlotWith(Cheap));
+		    });
+
+		for (int n = 0; n < 3; n++)
+			Signal(10);
+
+		// Neither the slow slot, nor copying the slots before the first one, count towards the cheap slot
+		const std::vector<el::SlotStats> Slots = Signal.GetInstrumentation().GetSlotStats();
+		Assert::AreEqual(Reported, 3); // Reported == 3
+		Assert::IsTrue(Slots[0].Percentile(1.0) < std::chrono::milliseconds(1));
+		Assert::IsTrue(Slots[1].TimeSpent >= std::chrono::milliseconds(30));
+	}
+
+	TEST_METHOD(InstrumentationSlowSlot)
+	{
+		int                  Reported = 0;
+		std::uint64_t        SlowId   = 0;
+		el::Event<void(int)> Signal;
+		Signal.Connect([](int) {});
+		Signal.Connect([](int aSleep) { std::this_thread::sleep_for(std::chrono::milliseconds(aSleep)); });
+
+		Signal.GetInstrumentation().SetSlowSlotHandler(
+		    std::chrono::milliseconds(5), [&](const el::SlotStats & aSlot, std::chrono::nanoseconds aElapsed) {
+			    Reported++;
+			    SlowId = aSlot.Id;
+			    Assert::IsTrue(aElapsed >= std::chrono::milliseconds(5));
+		    });
+
+		Signal(0);
+		Assert::AreEqual(Reported, 0); // Reported == 0
+
+		Signal(10);
+		Assert::AreEqual(Reported, 1); // Reported == 1
+		Assert::AreEqual(SlowId, std::uint64_t(1));
+
+		// Slow calls end up in the upper buckets of the histogram
+		const el::SlotStats Slow = Signal.GetInstrumentation().GetSlotStats()[1];
+		Assert::IsTrue(Slow.Percentile(1.0) >= std::chrono::milliseconds(5));
+	}
+
+	TEST_METHOD(InstrumentationThreads)
+	{
+		el::Event<void()> Signal;
+		Signal.Connect([]() {});
+
+		std::vector<std::thread> Threads;
+		for (int t = 0; t < 4; t++)
+		{
+			Threads.emplace_back([&Signal]() {
+				for (int i = 0; i < 1000; i++)
+					Signal();
+			});
+		}
+		for (std::thread & Thread : Threads)
+			Thread.join();
+
+		Assert::AreEqual(Signal.GetInstrumentation().GetStats().Dispatches, std::uint64_t(4000));
+		Assert::AreEqual(Signal.GetInstrumentation().GetSlotStats()[0].Calls, std::uint64_t(4000));
+	}
+
+	TEST_METHOD(InstrumentationPublisher)
+	{
+		el::Publisher<int, int> Pub;
+		Pub.Register(1, [](int) {});
+		Pub.Publish(1, 0);
+		Pub.Publish(1, 0);
+		Pub.Publish(2, 0);
+
+		Assert::IsTrue(Pub.GetInstrumentation(2) == nullptr);
+		Assert::AreEqual(Pub.GetInstrumentation(1)->GetStats().Dispatches, std::uint64_t(2));
+	}
+};
+
+} // namespace EventLibTest
+
+#endif // EL_ENABLE_INSTRUMENTATION
@@ -0,0 +1,127 @@
+// Stand-in for the parts of the Visual Studio CppUnitTest framework that the tests use, so that the same test files
+// can be built and run by CTest on Linux. Every TEST_METHOD registers itself, and main.cpp runs them all.
+
+#pragma once
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Microsoft
+{
+namespace VisualStudio
+{
+namespace CppUnitTestFramework
+{
+
+struct TestEntry
+{
+	const char * Class;
+	const char * Method;
+	void (*Run)();
+};
+
+inline std::vector<TestEntry> & Tests()
+{
+	static std::vector<TestEntry> All;
+	return All;
+}
+
+template <typename Method>
+struct AutoRegister
+{
+	static const bool Registered;
+};
+
+template <typename Method>
+const bool AutoRegister<Method>::Registered =
+    (Tests().push_back(TestEntry{ Method::ClassName(), Method::Name(), &Method::Run }), true);
+
+template <typename T, typename NameType>
+struct TestClass
+{
+	using Self = T;
+
+	static const char * TestClassName()
+	{
+		return NameType::Get();
+	}
+};
+
+class Assert
+{
+	template <typename T>
+	static auto ToString(const T & aValue, int) -> decltype(std::declval<std::ostream &>() << aValue, std::string())
+	{
+		std::ostringstream Stream;
+		Stream << aValue;
+		return Stream.str();
+	}
+
+	template <typename T>
+	static std::string ToString(const T &, long)
+	{ // Not printable
+		return "?";
+	}
+
+public:
+	template <typename T>
+	static void AreEqual(const T & aExpected, const T & aActual, const wchar_t * = nullptr)
+	{
+		if (!(aExpected == aActual))
+			throw std::runtime_error("AreEqual failed: " + ToString(aExpected, 0) + " != " + ToString(aActual, 0));
+	}
+
+	static void IsTrue(bool aCondition, const wchar_t * = nullptr)
+	{
+		if (!aCondition)
+			throw std::runtime_error("IsTrue failed");
+	}
+
+	static void IsFalse(bool aCondition, const wchar_t * = nullptr)
+	{
+		if (aCondition)
+			throw std::runtime_error("IsFalse failed");
+	}
+};
+
+} // namespace CppUnitTestFramework
+} // namespace VisualStudio
+} // namespace Microsoft
+
+#define TEST_CLASS(className)                                                                                          \
+	struct className##_Name                                                                                            \
+	{                                                                                                                  \
+		static const char * Get()                                                                                      \
+		{                                                                                                              \
+			return #className;                                                                                         \
+		}                                                                                                              \
+	};                                                                                                                 \
+	class className : public ::Microsoft::VisualStudio::CppUnitTestFramework::TestClass<className, className##_Name>
+
+// Referring to the registration from a member function is what instantiates it
+#define TEST_METHOD(methodName)                                                                                        \
+	struct methodName##_Method                                                                                         \
+	{                                                                                                                  \
+		static const char * ClassName()                                                                                \
+		{                                                                                                              \
+			return Self::TestClassName();                                                                              \
+		}                                                                                                              \
+		static const char * Name()                                                                                     \
+		{                                                                                                              \
+			return #methodName;                                                                                        \
+		}                                                                                                              \
+		static void Run()                                                                                              \
+		{                                                                                                              \
+			Self Instance;                                                                                             \
+			Instance.methodName();                                                                                     \
+		}                                                                                                              \
+	};                                                                                                                 \
+	bool methodName##_Registered() const                                                                               \
+	{                                                                                                                  \
+		return ::Microsoft::VisualStudio::CppUnitTestFramework::AutoRegister<methodName##_Method>::Registered;         \
+	}                                                                                                                  \
+	void methodName()
@@ -0,0 +1,39 @@
+// Runs every registered test, or only those of which the class or method name contains the first argument.
+//
+// EventLibTests [<filter>]
+
+#include "CppUnitTest.h"
+
+#include <cstdio>
+#include <exception>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+int main(int argc, char ** argv)
+{
+	const std::string Filter = argc > 1 ? argv[1] : "";
+
+	int Run    = 0;
+	int Failed = 0;
+	for (const TestEntry & Test : Tests())
+	{
+		const std::string Name = std::string(Test.Class) + "::" + Test.Method;
+		if (Name.find(Filter) == std::string::npos)
+			continue;
+
+		Run++;
+		try
+		{
+			Test.Run();
+		}
+		catch (const std::exception & aError)
+		{
+			Failed++;
+			std::printf("FAILED %s: %s\n", Name.c_str(), aError.what());
+		}
+	}
+
+	std::printf("%d of %d tests passed\n", Run - Failed, Run);
+	return Failed == 0 ? 0 : 1;
+}
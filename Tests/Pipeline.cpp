@@ -0,0 +1,111 @@
+#include "CppUnitTest.h"
+
+#include <EventLib/Pipeline.hpp>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace EventLibTest
+{
+
+TEST_CLASS(PipelineTest)
+{
+public:
+	TEST_METHOD(PipelineFilterMapSink)
+	{
+		el::Event<void(int)>         Source;
+		el::Event<void(std::string)> Target;
+
+		std::string Text;
+		Target.Connect([&Text](std::string aText) { Text += aText; });
+
+		Source | el::Filter([](int aValue) { return aValue % 2 == 0; }) | el::Map([](int aValue) { return aValue * 10; })
+		    | el::Map([](int aValue) { return std::to_string(aValue) + " "; }) | el::Sink(Target);
+
+		for (int i = 0; i < 5; i++)
+			Source(i);
+
+		Assert::AreEqual(Text, std::string("0 20 40 "));
+	}
+
+	TEST_METHOD(PipelineMapChain)
+	{
+		el::Event<void(int)> Source;
+		el::Event<void(int)> Target;
+
+		int i = 0;
+		Target.Connect([&i](int aValue) { i += aValue; });
+
+		Source | el::Map([](int aValue) { return aValue + 1; }) | el::Map([](int aValue) { return aValue * 2; })
+		    | el::Sink(Target);
+		Source(1);
+
+		Assert::AreEqual(i, 4); // i == 4
+	}
+
+	TEST_METHOD(PipelineMultipleArguments)
+	{
+		el::Event<void(int, int)> Source;
+		el::Event<void(int, int)> Passed;
+		el::Event<void(int)>      Summed;
+
+		int i = 0;
+		int j = 0;
+		Passed.Connect([&i](int aA, int aB) { i += aA * aB; });
+		Summed.Connect([&j](int aSum) { j += aSum; });
+
+		Source | el::Filter([](int aA, int aB) { return aA < aB; }) | el::Sink(Passed);
+		Source | el::Map([](int aA, int aB) { return aA + aB; }) | el::Sink(Summed);
+
+		Source(2, 3);
+		Source(3, 2);
+
+		Assert::AreEqual(i, 6);  // i == 6
+		Assert::AreEqual(j, 10); // j == 10
+	}
+
+	TEST_METHOD(PipelineFanOut)
+	{ // A named pipeline keeps its stages when it gets connected
+		el::Event<void(int)>         Source;
+		el::Event<void(std::string)> First;
+		el::Event<void(std::string)> Second;
+
+		std::string FirstText;
+		std::string SecondText;
+		First.Connect([&FirstText](std::string aText) { FirstText += aText; });
+		Second.Connect([&SecondText](std::string aText) { SecondText += aText; });
+
+		const std::string Prefix = "value=";
+		auto Named = Source | el::Map([Prefix](int aValue) { return Prefix + std::to_string(aValue); });
+		Named.Into(First);
+		Named | el::Sink(Second);
+		Named.Then(el::Filter([](const std::string &) { return false; })).Into(Second);
+
+		Source(7);
+
+		Assert::AreEqual(FirstText, std::string("value=7"));
+		Assert::AreEqual(SecondText, std::string("value=7"));
+	}
+
+	TEST_METHOD(PipelineDisconnect)
+	{
+		el::Event<void(int)> Source;
+		el::Event<void(int)> Target;
+
+		int i = 0;
+		Target.Connect([&i](int aValue) { i += aValue; });
+
+		el::Connection connection = Source | el::Filter([](int aValue) { return aValue > 0; }) | el::Sink(Target);
+		Source(1);
+		Source(-1);
+
+		Assert::AreEqual(i, 1); // i == 1
+
+		connection.Disconnect();
+		Source(1);
+
+		Assert::AreEqual(i, 1); // i == 1
+	}
+};
+
+} // namespace EventLibTest
@@ -0,0 +1,174 @@
+#include "CppUnitTest.h"
+
+#include <EventLib/RateLimit.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace EventLibTest
+{
+
+TEST_CLASS(RateLimitTest)
+{
+public:
+	TEST_METHOD(ThrottleLeadingAndTrailing)
+	{
+		el::Event<void(int)>         Source;
+		el::TimerManager<int>        Manager;
+		el::Throttle<void(int), int> Throttled(Source, Manager, 10);
+
+		int Calls = 0;
+		int Last  = 0;
+		Throttled.Output.Connect([&Calls, &Last](int aValue) {
+			Calls++;
+			Last = aValue;
+		});
+
+		Source(1); // Passes through right away
+		Source(2);
+		Source(3);
+
+		Assert::AreEqual(Calls, 1); // Calls == 1
+		Assert::AreEqual(Last, 1);  // Last == 1
+
+		Manager.UpdateTimers(10); // End of the interval passes on the latest call
+
+		Assert::AreEqual(Calls, 2); // Calls == 2
+		Assert::AreEqual(Last, 3);  // Last == 3
+
+		Manager.UpdateTimers(10); // Nothing happened, so the throttle goes idle
+		Source(4);
+
+		Assert::AreEqual(Calls, 3); // Calls == 3
+		Assert::AreEqual(Last, 4);  // Last == 4
+	}
+
+	TEST_METHOD(DebounceWaitsForQuiet)
+	{
+		el::Event<void(int)>         Source;
+		el::TimerManager<int>        Manager;
+		el::Debounce<void(int), int> Debounced(Source, Manager, 10);
+
+		int Calls = 0;
+		int Last  = 0;
+		Debounced.Output.Connect([&Calls, &Last](int aValue) {
+			Calls++;
+			Last = aValue;
+		});
+
+		Source(1);
+		Manager.UpdateTimers(6);
+		Source(2); // Restarts the wait
+		Manager.UpdateTimers(6);
+
+		Assert::AreEqual(Calls, 0); // Calls == 0
+
+		Manager.UpdateTimers(4);
+
+		Assert::AreEqual(Calls, 1); // Calls == 1
+		Assert::AreEqual(Last, 2);  // Last == 2
+
+		Manager.UpdateTimers(20);
+
+		Assert::AreEqual(Calls, 1); // Calls == 1
+	}
+
+	TEST_METHOD(SampleEveryInterval)
+	{
+		el::Event<void(int)>       Source;
+		el::TimerManager<int>      Manager;
+		el::Sample<void(int), int> Sampled(Source, Manager, 10);
+
+		int Calls = 0;
+		int Last  = 0;
+		Sampled.Output.Connect([&Calls, &Last](int aValue) {
+			Calls++;
+			Last = aValue;
+		});
+
+		Source(1);
+		Source(2);
+
+		Assert::AreEqual(Calls, 0); // Calls == 0
+
+		Manager.UpdateTimers(10);
+
+		Assert::AreEqual(Calls, 1); // Calls == 1
+		Assert::AreEqual(Last, 2);  // Last == 2
+
+		Manager.UpdateTimers(10); // No new calls, nothing is passed on
+
+		Assert::AreEqual(Calls, 1); // Calls == 1
+
+		Source(3);
+		Manager.UpdateTimers(10);
+
+		Assert::AreEqual(Calls, 2); // Calls == 2
+		Assert::AreEqual(Last, 3);  // Last == 3
+	}
+
+	TEST_METHOD(RateLimitSourceOnOtherThread)
+	{ // The source is called on its own thread, while this thread updates the timers
+		el::Event<void(int)>         Source;
+		el::TimerManager<int>        Manager;
+		el::Throttle<void(int), int> Throttled(Source, Manager, 5);
+		el::Debounce<void(int), int> Debounced(Source, Manager, 5);
+		std::atomic<int>             ThrottleCalls(0);
+		std::atomic<int>             ThrottleLast(0);
+		std::atomic<int>             DebounceLast(0);
+		Throttled.Output.Connect([&](int aValue) {
+			ThrottleCalls++;
+			ThrottleLast = aValue;
+		});
+		Debounced.Output.Connect([&](int aValue) { DebounceLast = aValue; });
+
+		std::atomic<bool> Done(false);
+		std::thread       Producer([&]() {
+			for (int n = 1; n <= 200; n++)
+			{
+				Source(n);
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+			}
+			Done = true;
+		});
+
+		int Updates = 0;
+		while (!Done)
+		{
+			Manager.UpdateTimers(1);
+			Updates++;
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		}
+		Producer.join();
+		for (int n = 0; n < 20; n++)
+			Manager.UpdateTimers(1);
+
+		// The latest call always comes through, and the throttle passed on no more than one call per interval
+		Assert::AreEqual(ThrottleLast.load(), 200);
+		Assert::AreEqual(DebounceLast.load(), 200);
+		Assert::IsTrue(ThrottleCalls.load() <= (Updates + 20) / 5 + 2);
+	}
+
+	TEST_METHOD(RateLimitDisconnectsOnDestroy)
+	{
+		el::Event<void(int)>  Source;
+		el::TimerManager<int> Manager;
+
+		int Calls = 0;
+		{
+			el::Throttle<void(int), int> Throttled(Source, Manager, 10);
+			Throttled.Output.Connect([&Calls](int) { Calls++; });
+			Source(1);
+			Source(2);
+		}
+
+		Source(3);
+		Manager.UpdateTimers(10);
+
+		Assert::AreEqual(Calls, 1); // Calls == 1
+	}
+};
+
+} // namespace EventLibTest
@@ -0,0 +1,135 @@
+#ifdef __linux__
+
+#include "CppUnitTest.h"
+
+#include <EventLib/SharedPublisher.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace EventLibTest
+{
+
+TEST_CLASS(SharedPublisherTest)
+{
+public:
+	TEST_METHOD(SharedPublisherSameProcess)
+	{
+		const std::string Name = "/EventLibTest_" + std::to_string(getpid()) + "_a";
+
+		int  i = 0;
+		auto IncrementI = [&i](int aValue) -> void { i += aValue; };
+
+		el::SharedPublisher<int, int> Sender(Name);
+		el::SharedPublisher<int, int> Receiver(Name);
+		el::SharedPublisher<int, int>::Unlink(Name);
+
+		Receiver.Register(1, IncrementI);
+
+		Sender.Publish(1, 10);
+		Sender.Publish(2, 100); // Nothing registered to key `2`
+		Sender(1, 1000);
+
+		Assert::AreEqual(i, 0); // Nothing is called before dispatching
+
+		Assert::AreEqual(Receiver.Dispatch(), size_t(3));
+		Assert::AreEqual(i, 1010); // i == 1010
+		Assert::AreEqual(Sender.GetWriteDroppedCount(), uint64_t(0));
+	}
+
+	TEST_METHOD(SharedPublisherOtherProcess)
+	{
+		const std::string Name = "/EventLibTest_" + std::to_string(getpid()) + "_b";
+
+		int  i = 0;
+		auto IncrementI = [&i](int aValue) -> void { i += aValue; };
+
+		el::SharedPublisher<int, int> Receiver(Name);
+		Receiver.Register(0, IncrementI);
+
+		pid_t Child = fork();
+		if (Child == 0)
+		{ // Publish from a separate process
+			el::SharedPublisher<int, int> Sender(Name);
+			for (int n = 1; n <= 100; n++)
+				Sender.Publish(0, n);
+			_exit(0);
+		}
+
+		for (int Attempts = 0; i != 5050 && Attempts < 1000; Attempts++)
+			Receiver.WaitAndDispatch(std::chrono::milliseconds(10));
+
+		waitpid(Child, nullptr, 0);
+		el::SharedPublisher<int, int>::Unlink(Name);
+
+		Assert::AreEqual(i, 5050); // Sum of 1 to 100
+		Assert::AreEqual(Receiver.GetDroppedCount(), uint64_t(0));
+	}
+
+	TEST_METHOD(SharedPublisherDeadWriter)
+	{
+		const std::string Name = "/EventLibTest_" + std::to_string(getpid()) + "_d";
+
+		int  i = 0;
+		auto IncrementI = [&i](int aValue) -> void { i += aValue; };
+
+		el::SharedPublisher<int, int> Publisher(Name);
+		Publisher.Register(0, IncrementI);
+
+		{ // Take an index without ever writing it, like a writer that died right after; the write index is the first
+		  // field on the second cache line of the region
+			const int Descriptor = shm_open(Name.c_str(), O_RDWR, 0600);
+			void *    Region     = mmap(nullptr, 128, PROT_READ | PROT_WRITE, MAP_SHARED, Descriptor, 0);
+			reinterpret_cast<std::atomic<std::uint64_t> *>(static_cast<char *>(Region) + 64)->fetch_add(1);
+			munmap(Region, 128);
+			close(Descriptor);
+		}
+		el::SharedPublisher<int, int>::Unlink(Name);
+		Publisher.Publish(0, 10);
+
+		// Waiting for the missing message sleeps instead of returning straight away
+		const auto Start = std::chrono::steady_clock::now();
+		Assert::AreEqual(Publisher.WaitAndDispatch(std::chrono::milliseconds(20)), size_t(0));
+		Assert::IsTrue(std::chrono::steady_clock::now() - Start >= std::chrono::milliseconds(15));
+
+		// Once the writer is presumed dead, the message is skipped and the ones after it are read
+		for (int Attempts = 0; i == 0 && Attempts < 100; Attempts++)
+			Publisher.WaitAndDispatch(std::chrono::milliseconds(10));
+
+		Assert::AreEqual(i, 10); // i == 10
+		Assert::AreEqual(Publisher.GetDroppedCount(), uint64_t(1));
+	}
+
+	TEST_METHOD(SharedPublisherOverrun)
+	{
+		const std::string Name = "/EventLibTest_" + std::to_string(getpid()) + "_c";
+
+		int  i = 0;
+		auto IncrementI = [&i](int) -> void { i++; };
+
+		el::SharedPublisher<int, int> Publisher(Name, 16);
+		el::SharedPublisher<int, int>::Unlink(Name);
+
+		Publisher.Register(0, IncrementI);
+
+		for (int n = 0; n < 40; n++)
+			Publisher.Publish(0, n);
+
+		// Only the last 16 messages are still in the ring buffer
+		Publisher.Dispatch();
+
+		Assert::AreEqual(i, 16);
+		Assert::AreEqual(Publisher.GetDroppedCount(), uint64_t(24));
+	}
+};
+
+} // namespace EventLibTest
+
+#endif // __linux__
@@ -0,0 +1,126 @@
+#include "CppUnitTest.h"
+
+#include <EventLib/Timer.hpp>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace EventLibTest
+{
+
+TEST_CLASS(TimerTest)
+{
+public:
+	TEST_METHOD(TimerTrigger)
+	{
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::TimerManager<int> Manager;
+		Manager.Create(10)->OnTrigger.Connect(IncrementI);
+		Manager.Create(5, true)->OnTrigger.Connect(IncrementI);
+
+		Manager.UpdateTimers(5);
+
+		Assert::AreEqual(i, 1); // i == 1
+
+		Manager.UpdateTimers(5);
+
+		Assert::AreEqual(i, 3); // i == 3
+
+		Manager.UpdateTimers(5);
+
+		Assert::AreEqual(i, 4); // The first timer has finished
+	}
+
+	TEST_METHOD(TimerPauseAfterTrigger)
+	{
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::TimerManager<int> Manager;
+		auto                  Timer = Manager.Create(10);
+		Timer->OnTrigger.Connect(IncrementI);
+
+		Manager.UpdateTimers(10);
+		Timer->Pause();
+		Manager.UpdateTimers(1);
+		Timer->Resume();
+		Manager.UpdateTimers(1);
+
+		Assert::AreEqual(i, 1); // Pausing and resuming does not make a finished timer fire again
+
+		Timer->SetTimeLeft(5);
+		Manager.UpdateTimers(5);
+
+		Assert::AreEqual(i, 1); // Removed after it had finished
+	}
+
+	TEST_METHOD(TimerPausedByEarlierTimer)
+	{
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::TimerManager<int> Manager;
+		auto                  First  = Manager.Create(10);
+		auto                  Second = Manager.Create(10);
+		First->OnTrigger.Connect([&Second]() { Second->Pause(); });
+		Second->OnTrigger.Connect(IncrementI);
+
+		Manager.UpdateTimers(10);
+
+		Assert::AreEqual(i, 0);                      // Paused before its turn, so it did not fire
+		Assert::AreEqual(Second->GetTimeLeft(), 10); // Nor was it counted down
+
+		Second->Resume();
+		Manager.UpdateTimers(10);
+
+		Assert::AreEqual(i, 1); // i == 1
+	}
+
+	TEST_METHOD(TimerSlack)
+	{
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::TimerManager<int> Manager;
+
+		// Due at 10, but can wait until 30 to fire along with another timer
+		auto Loose = Manager.Create(10, false, 20);
+		Loose->OnTrigger.Connect(IncrementI);
+		Manager.Create(25)->OnTrigger.Connect(IncrementI);
+
+		Manager.UpdateTimers(10);
+		Manager.UpdateTimers(10);
+
+		Assert::AreEqual(i, 0); // Waiting within its slack
+
+		Manager.UpdateTimers(5);
+
+		Assert::AreEqual(i, 2); // Both fired in the same update
+
+		auto Stats = Manager.GetCoalescingStats();
+		Assert::AreEqual(Stats.Triggers, size_t(2));
+		Assert::AreEqual(Stats.Batches, size_t(1));
+		Assert::AreEqual(Stats.Coalesced, size_t(1));
+	}
+
+	TEST_METHOD(TimerSlackDeadline)
+	{
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::TimerManager<int> Manager;
+		Manager.Create(10, false, 5)->OnTrigger.Connect(IncrementI);
+
+		Manager.UpdateTimers(14);
+
+		Assert::AreEqual(i, 0); // i == 0
+
+		Manager.UpdateTimers(1);
+
+		Assert::AreEqual(i, 1); // Fires alone once it runs out of slack
+		Assert::AreEqual(Manager.GetCoalescingStats().Coalesced, size_t(0));
+	}
+};
+
+} // namespace EventLibTest
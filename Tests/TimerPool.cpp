@@ -0,0 +1,184 @@
+#include "CppUnitTest.h"
+
+#include <EventLib/TimerPool.hpp>
+#include <chrono>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace EventLibTest
+{
+
+TEST_CLASS(TimerPoolTest)
+{
+public:
+	TEST_METHOD(TimerPoolTrigger)
+	{
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::TimerPool<float> Pool;
+
+		// Enough timers to cover both the vectorised loop and the remainder
+		for (int n = 1; n <= 11; n++)
+			Pool.Create(float(n), false, IncrementI);
+
+		Pool.UpdateTimers(4.5f);
+
+		Assert::AreEqual(i, 4); // i == 4
+		Assert::AreEqual(Pool.GetFired().size(), size_t(4));
+		Assert::AreEqual(Pool.Count(), size_t(7)); // Finished timers are removed
+
+		Pool.UpdateTimers(100.0f);
+
+		Assert::AreEqual(i, 11); // i == 11
+		Assert::AreEqual(Pool.Count(), size_t(0));
+	}
+
+	TEST_METHOD(TimerPoolLooping)
+	{
+		el::TimerPool<std::chrono::milliseconds> Pool;
+
+		auto Timer = Pool.Create(std::chrono::milliseconds(10), true);
+
+		Pool.UpdateTimers(std::chrono::milliseconds(7));
+		Assert::AreEqual(Pool.GetFired().size(), size_t(0));
+
+		Pool.UpdateTimers(std::chrono::milliseconds(7));
+		Assert::AreEqual(Pool.GetFired().size(), size_t(1));
+		Assert::AreEqual(Pool.GetFired()[0], Timer);
+		Assert::IsTrue(Pool.GetTimeLeft(Timer) == std::chrono::milliseconds(10)); // Restarted from the interval
+	}
+
+	TEST_METHOD(TimerPoolPause)
+	{
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::TimerPool<int> Pool;
+
+		auto First  = Pool.Create(10, false, IncrementI);
+		auto Second = Pool.Create(10, false, IncrementI);
+		auto Third  = Pool.Create(10, false, IncrementI);
+
+		Pool.UpdateTimers(4);
+		Pool.Pause(Second);
+		Pool.UpdateTimers(6);
+
+		Assert::AreEqual(i, 2); // i == 2
+		Assert::IsTrue(Pool.Contains(Second));
+		Assert::IsFalse(Pool.Contains(First));
+		Assert::IsFalse(Pool.Contains(Third));
+		Assert::AreEqual(Pool.GetTimeLeft(Second), 6);
+
+		Pool.Resume(Second);
+		Pool.UpdateTimers(6);
+
+		Assert::AreEqual(i, 3); // i == 3
+	}
+
+	TEST_METHOD(TimerPoolInt32)
+	{
+		el::TimerPool<int> Pool;
+
+		// Two passes of four, and a remainder
+		for (int n = 1; n <= 9; n++)
+			Pool.Create(n * 10, n % 2 == 0);
+
+		Pool.UpdateTimers(45);
+
+		Assert::AreEqual(Pool.GetFired().size(), size_t(4));
+		Assert::AreEqual(Pool.Count(), size_t(7)); // The two looping timers that fired are kept
+
+		Pool.UpdateTimers(50);
+
+		Assert::AreEqual(Pool.GetFired().size(), size_t(7)); // The remaining five, and both looping timers again
+		Assert::AreEqual(Pool.Count(), size_t(4));
+	}
+
+	TEST_METHOD(TimerPoolInt64)
+	{
+		el::TimerPool<std::chrono::milliseconds> Pool;
+
+		// Two passes of two, and a remainder
+		for (int n = 1; n <= 5; n++)
+			Pool.Create(std::chrono::milliseconds(n * 10));
+
+		Pool.UpdateTimers(std::chrono::milliseconds(30));
+
+		Assert::AreEqual(Pool.GetFired().size(), size_t(3));
+		Assert::AreEqual(Pool.Count(), size_t(2));
+
+		Pool.UpdateTimers(std::chrono::milliseconds(15));
+
+		Assert::AreEqual(Pool.GetFired().size(), size_t(1));
+		Assert::IsTrue(Pool.GetTimeLeft(Pool.GetFired()[0]) == std::chrono::milliseconds(0)); // Removed
+	}
+
+	TEST_METHOD(TimerPoolStaleHandle)
+	{
+		el::TimerPool<int> Pool;
+
+		auto Removed = Pool.Create(10);
+		auto Other   = Pool.Create(20);
+		Pool.Remove(Removed);
+
+		// A removed handle does not touch the timer that took its place
+		Pool.SetTimeLeft(Removed, 1);
+		Pool.Reset(Removed);
+
+		Assert::AreEqual(Pool.GetTimeLeft(Removed), 0);
+		Assert::AreEqual(Pool.GetTimeLeft(Other), 20);
+	}
+
+	TEST_METHOD(TimerPoolStaleHandleReused)
+	{
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::TimerPool<int> Pool;
+
+		auto Removed = Pool.Create(10);
+		Pool.Remove(Removed);
+		auto Reused = Pool.Create(20, false, IncrementI); // Takes over the slot of the removed timer
+
+		// The stale handle does not refer to the timer that reused its slot
+		Assert::IsFalse(Pool.Contains(Removed));
+		Pool.SetTimeLeft(Removed, 1);
+		Pool.Pause(Removed);
+		Pool.Remove(Removed);
+
+		Assert::IsTrue(Pool.Contains(Reused));
+		Assert::IsFalse(Pool.IsPaused(Reused));
+		Assert::AreEqual(Pool.GetTimeLeft(Removed), 0);
+		Assert::AreEqual(Pool.GetTimeLeft(Reused), 20);
+
+		Pool.UpdateTimers(20);
+		Assert::AreEqual(i, 1); // i == 1
+		Assert::IsTrue(Pool.GetFired()[0] == Reused);
+	}
+
+	TEST_METHOD(TimerPoolRemoveWhileFiring)
+	{
+		int i = 0;
+
+		el::TimerPool<double> Pool;
+
+		el::TimerPool<double>::Handle Second = 0;
+		auto First = Pool.Create(1.0, true, [&]() {
+			i++;
+			Pool.Remove(Second);
+		});
+		Second = Pool.Create(1.0, true, [&i]() { i += 10; });
+		Pool.Create(1.0, true, [&]() {
+			i += 100;
+			Pool.Remove(First);
+		});
+
+		Pool.UpdateTimers(1.0);
+
+		Assert::AreEqual(i, 101); // Second was removed before it got called
+		Assert::AreEqual(Pool.Count(), size_t(1));
+	}
+};
+
+} // namespace EventLibTest
@@ -0,0 +1,145 @@
+#include "CppUnitTest.h"
+
+#include <EventLib/TimerService.hpp>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace EventLibTest
+{
+
+TEST_CLASS(TimerServiceTest)
+{
+public:
+	TEST_METHOD(TimerServiceSchedule)
+	{
+		std::atomic<int> i(0);
+		auto IncrementI = [&i]() -> void { i++; };
+
+		{
+			el::TimerService Service(2);
+
+			Service.Schedule(std::chrono::milliseconds(1), IncrementI);
+			Service.Schedule(std::chrono::milliseconds(5), IncrementI);
+
+			for (int Attempts = 0; i != 2 && Attempts < 1000; Attempts++)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		Assert::AreEqual(i.load(), 2); // i == 2
+	}
+
+	TEST_METHOD(TimerServiceCancel)
+	{
+		std::atomic<int> i(0);
+		auto IncrementI = [&i](int aValue) -> void { i += aValue; };
+
+		{
+			el::TimerService Service;
+
+			el::TimerService::Handle Handle = Service.Schedule(std::chrono::milliseconds(20), std::bind(IncrementI, 1));
+			Service.Schedule(std::chrono::milliseconds(40), std::bind(IncrementI, 10));
+
+			Handle.Cancel();
+
+			for (int Attempts = 0; i == 0 && Attempts < 1000; Attempts++)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		Assert::AreEqual(i.load(), 10); // i == 10
+	}
+
+	TEST_METHOD(TimerServiceCompactCancelled)
+	{
+		el::TimerService Service;
+
+		el::TimerService::Handle Kept = Service.Schedule(std::chrono::hours(1), []() {});
+		for (int n = 0; n < 1000; n++)
+		{
+			el::TimerService::Handle Handle = Service.Schedule(std::chrono::hours(1), []() {});
+			Handle.Cancel();
+		}
+
+		// Cancelled callbacks do not pile up until their deadline
+		Assert::IsTrue(Service.PendingCount() < 128);
+		Assert::IsTrue(Service.PendingCount() >= 1);
+		Assert::IsFalse(Kept.Cancelled());
+	}
+
+	TEST_METHOD(TimerServiceScheduleWhileWaiting)
+	{ // Scheduling grows the queue while the scheduler waits for its earliest deadline
+		std::atomic<int> i(0);
+		auto IncrementI = [&i]() -> void { i++; };
+
+		{
+			el::TimerService Service;
+
+			Service.Schedule(std::chrono::milliseconds(20), IncrementI);
+			std::this_thread::sleep_for(std::chrono::milliseconds(2)); // Let the scheduler start waiting
+			for (int n = 0; n < 200; n++)
+				Service.Schedule(std::chrono::milliseconds(30 + n % 10), IncrementI);
+
+			for (int Attempts = 0; i != 201 && Attempts < 1000; Attempts++)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		Assert::AreEqual(i.load(), 201); // i == 201
+	}
+
+	TEST_METHOD(TimerServiceSharedBlocking)
+	{ // A callback on the shared service can wait for another one
+		std::atomic<bool> Released(false);
+		std::atomic<bool> Done(false);
+
+		el::TimerService::Shared().Schedule(std::chrono::milliseconds(1), [&]() {
+			for (int Attempts = 0; !Released && Attempts < 1000; Attempts++)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			Done = Released.load();
+		});
+		el::TimerService::Shared().Schedule(std::chrono::milliseconds(2), [&]() { Released = true; });
+
+		for (int Attempts = 0; !Done && Attempts < 2000; Attempts++)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		Assert::IsTrue(Done.load());
+	}
+
+	TEST_METHOD(TimerServiceOrder)
+	{
+		std::mutex       Mutex;
+		std::vector<int> Order;
+		auto Append = [&](int aValue) -> void {
+			std::lock_guard<std::mutex> Lock(Mutex);
+			Order.push_back(aValue);
+		};
+
+		{
+			el::TimerService Service; // A single worker runs callbacks in deadline order
+
+			const auto Now = std::chrono::steady_clock::now();
+			Service.ScheduleAt(Now + std::chrono::milliseconds(30), std::bind(Append, 3));
+			Service.ScheduleAt(Now + std::chrono::milliseconds(10), std::bind(Append, 1));
+			Service.ScheduleAt(Now + std::chrono::milliseconds(20), std::bind(Append, 2));
+
+			for (int Attempts = 0; Attempts < 1000; Attempts++)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				std::lock_guard<std::mutex> Lock(Mutex);
+				if (Order.size() == 3)
+					break;
+			}
+		}
+
+		Assert::AreEqual(Order.size(), size_t(3));
+		Assert::AreEqual(Order[0], 1);
+		Assert::AreEqual(Order[1], 2);
+		Assert::AreEqual(Order[2], 3);
+	}
+};
+
+} // namespace EventLibTest
@@ -0,0 +1,129 @@
+#include "CppUnitTest.h"
+
+#include <EventLib/TimerWheel.hpp>
+#include <chrono>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using Milliseconds = std::chrono::milliseconds;
+
+namespace EventLibTest
+{
+
+TEST_CLASS(TimerWheelTest)
+{
+public:
+	TEST_METHOD(TimerWheelTrigger)
+	{
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::TimerWheel<Milliseconds> Wheel(Milliseconds(1));
+
+		auto Timer = Wheel.Create(Milliseconds(10));
+		Timer->OnTrigger.Connect(IncrementI);
+
+		Wheel.UpdateTimers(Milliseconds(9));
+
+		Assert::AreEqual(i, 0); // i == 0
+		Assert::IsTrue(Timer->GetTimeLeft() == Milliseconds(1));
+
+		Wheel.UpdateTimers(Milliseconds(1));
+
+		Assert::AreEqual(i, 1); // i == 1
+		Assert::AreEqual(Wheel.Count(), size_t(0)); // Finished timers are removed
+
+		Wheel.UpdateTimers(Milliseconds(100));
+
+		Assert::AreEqual(i, 1); // i == 1
+	}
+
+	TEST_METHOD(TimerWheelLooping)
+	{
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::TimerWheel<Milliseconds> Wheel(Milliseconds(1));
+		Wheel.Create(Milliseconds(5), true)->OnTrigger.Connect(IncrementI);
+
+		// Timers fire once for every interval that passed, even within a single update
+		Wheel.UpdateTimers(Milliseconds(23));
+
+		Assert::AreEqual(i, 4); // i == 4
+		Assert::AreEqual(Wheel.Count(), size_t(1));
+	}
+
+	TEST_METHOD(TimerWheelPause)
+	{
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::TimerWheel<Milliseconds> Wheel(Milliseconds(1));
+
+		auto Timer = Wheel.Create(Milliseconds(10));
+		Timer->OnTrigger.Connect(IncrementI);
+
+		Wheel.UpdateTimers(Milliseconds(4));
+		Timer->Pause();
+		Wheel.UpdateTimers(Milliseconds(100));
+
+		Assert::AreEqual(i, 0); // i == 0
+		Assert::IsTrue(Timer->GetTimeLeft() == Milliseconds(6));
+
+		Timer->Resume();
+		Wheel.UpdateTimers(Milliseconds(6));
+
+		Assert::AreEqual(i, 1); // i == 1
+	}
+
+	TEST_METHOD(TimerWheelDelete)
+	{
+		int  i = 0;
+		auto IncrementI = [&i]() -> void { i++; };
+
+		el::TimerWheel<Milliseconds> Wheel(Milliseconds(1));
+
+		auto Timer = Wheel.Create(Milliseconds(10));
+		Timer->OnTrigger.Connect(IncrementI);
+		Timer->Delete();
+
+		Wheel.UpdateTimers(Milliseconds(20));
+
+		Assert::AreEqual(i, 0); // i == 0
+		Assert::AreEqual(Wheel.Count(), size_t(0));
+	}
+
+	TEST_METHOD(TimerWheelCascade)
+	{
+		int i = 0;
+
+		el::TimerWheel<Milliseconds> Wheel(Milliseconds(1));
+
+		// Far enough away to be stored in higher levels, and beyond the range of the wheel
+		for (long long Delay : { 100LL, 5000LL, 300000LL, 20000000LL })
+		{
+			// The wheel keeps the timer alive, capturing a shared pointer in its own event would keep it alive forever
+			auto * Timer = Wheel.Create(Milliseconds(Delay)).get();
+			Timer->OnTrigger.Connect([&i, Timer]() {
+				Assert::IsTrue(Timer->GetTimeLeft() <= Milliseconds(0));
+				i++;
+			});
+		}
+
+		Wheel.UpdateTimers(Milliseconds(99));
+		Assert::AreEqual(i, 0);
+		Wheel.UpdateTimers(Milliseconds(1));
+		Assert::AreEqual(i, 1);
+		Wheel.UpdateTimers(Milliseconds(4899));
+		Assert::AreEqual(i, 1);
+		Wheel.UpdateTimers(Milliseconds(1));
+		Assert::AreEqual(i, 2);
+		Wheel.UpdateTimers(Milliseconds(295000));
+		Assert::AreEqual(i, 3);
+		Wheel.UpdateTimers(Milliseconds(20000000 - 300001));
+		Assert::AreEqual(i, 3);
+		Wheel.UpdateTimers(Milliseconds(1));
+		Assert::AreEqual(i, 4);
+	}
+};
+
+} // namespace EventLibTest
@@ -0,0 +1,99 @@
+#include "CppUnitTest.h"
+
+#include <EventLib/Event.hpp>
+#include <EventLib/EventQueue.hpp>
+#include <EventLib/Timer.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+#ifndef EL_DISABLE_TRACING
+
+namespace EventLibTest
+{
+
+namespace
+{
+
+std::size_t CountOf(const std::string & aText, const std::string & aPart)
+{
+	std::size_t Count = 0;
+	for (std::size_t Position = aText.find(aPart); Position != std::string::npos; Position = aText.find(aPart, Position + 1))
+		Count++;
+	return Count;
+}
+
+std::string Flush()
+{
+	std::ostringstream Stream;
+	el::Tracer::Shared().Flush(Stream);
+	return Stream.str();
+}
+
+} // namespace
+
+TEST_CLASS(TracingTest)
+{
+public:
+	TEST_METHOD(TracingDisabled)
+	{
+		Flush();
+
+		el::Event<void()> Signal("Disabled");
+		Signal.Connect([]() {});
+		Signal();
+
+		Assert::AreEqual(CountOf(Flush(), "\"ph\":\"X\""), std::size_t(0));
+	}
+
+	TEST_METHOD(TracingEvent)
+	{
+		Flush();
+		el::Tracer::Enable();
+
+		el::Event<void()> Signal("Signal \"quoted\"");
+		Signal.Connect([]() {});
+		Signal.Connect(3u, []() {});
+		Signal();
+
+		el::Tracer::Disable();
+		const std::string Trace = Flush();
+
+		Assert::IsTrue(Trace.find("{\"traceEvents\":[") == 0);
+		Assert::AreEqual(CountOf(Trace, "\"name\":\"Signal \\\"quoted\\\"\""), std::size_t(3)); // Dispatch and 2 slots
+		Assert::AreEqual(CountOf(Trace, "\"cat\":\"Slot\""), std::size_t(2));
+		Assert::AreEqual(CountOf(Trace, "\"group\":3"), std::size_t(1));
+
+		// Flushing empties the buffers
+		Assert::AreEqual(CountOf(Flush(), "\"ph\":\"X\""), std::size_t(0));
+	}
+
+	TEST_METHOD(TracingThreads)
+	{
+		Flush();
+		el::Tracer::Enable();
+
+		el::EventQueue<void()> Queue;
+		el::TimerManager<int>  Manager;
+		Manager.Create(1);
+		std::thread Other([&]() {
+			Queue.Connect([]() {});
+			Queue();
+		});
+		Other.join();
+		Manager.UpdateTimers(1);
+
+		el::Tracer::Disable();
+		const std::string Trace = Flush();
+
+		Assert::AreEqual(CountOf(Trace, "\"cat\":\"EventQueue\""), std::size_t(1));
+		Assert::AreEqual(CountOf(Trace, "\"name\":\"TimerManager::UpdateTimers\""), std::size_t(1));
+		Assert::IsTrue(CountOf(Trace, "\"name\":\"thread_name\"") >= 2);
+	}
+};
+
+} // namespace EventLibTest
+
+#endif // EL_DISABLE_TRACING
@@ -0,0 +1,274 @@
+#pragma region Copyright (c) 2017 Hielke Morsink
+/*****************************************************************************
+ * EventLib, a C++ library to provide classes for event-based programming.
+ *
+ * EventLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#ifndef EL_NO_THREADSAFETY_CHECKS
+#include <mutex>
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+#include "Timer.hpp"
+
+namespace el
+{
+
+// Timer manager that stores absolute deadlines of a monotonic clock in a min-heap. Instead of being updated at a
+// fixed rate, an event loop can sleep until NextDeadline() and then call RunDue(), which only touches expired timers.
+// Looping timers are rescheduled relative to their previous deadline, so they do not drift, and fire once for every
+// interval that passed when an update comes in late.
+template <typename Clock = std::chrono::steady_clock>
+class DeadlineTimerManager
+{
+	using Time      = typename Clock::duration;
+	using TimePoint = typename Clock::time_point;
+	using _Timer    = Timer<Time, DeadlineTimerManager<Clock>>;
+	using _TimerPtr = std::shared_ptr<_Timer>;
+
+	friend _Timer;
+
+	enum class TimerState
+	{
+		Removed,
+		Scheduled,
+		Parked,
+		Firing
+	};
+
+	struct TimerData
+	{
+		TimerState                              State = TimerState::Removed;
+		TimePoint                               Deadline;
+		std::size_t                             HeapIndex = 0;
+		typename std::list<_TimerPtr>::iterator Position;
+	};
+
+public:
+	DeadlineTimerManager()                             = default;
+	DeadlineTimerManager(const DeadlineTimerManager &) = delete;
+
+	std::shared_ptr<_Timer> Create(const Time aSleepTime, bool aLooping = false)
+	{ // Create a timer that is due after the given time, and returns a shared pointer to it
+		_TimerPtr       ptr = std::make_shared<_Timer>(aSleepTime, aLooping, this);
+		const TimePoint Now = Clock::now();
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(TimersMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		Timers.push_back(ptr);
+		ptr->Data.Position = std::prev(Timers.end());
+		ptr->Data.Deadline = Now + aSleepTime;
+		Push(*ptr);
+		return ptr;
+	}
+
+	void Remove(const _TimerPtr & ptr)
+	{ // Removes a timer from the manager
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(TimersMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		if (ptr->Data.State == TimerState::Removed)
+			return;
+		if (ptr->Data.State == TimerState::Scheduled)
+			Erase(ptr->Data.HeapIndex);
+		ptr->Data.State = TimerState::Removed;
+		Timers.erase(ptr->Data.Position);
+	}
+
+	TimePoint NextDeadline() const
+	{ // Returns the deadline of the first timer to expire, or TimePoint::max() when there is none
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(TimersMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		return Heap.empty() ? TimePoint::max() : Heap.front()->Data.Deadline;
+	}
+
+	std::size_t RunDue()
+	{
+		return RunDue(Clock::now());
+	}
+
+	std::size_t RunDue(const TimePoint aNow)
+	{ // Fires all timers with a deadline at or before the given time, returns how often timers were triggered
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::unique_lock<std::mutex> lock(TimersMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+		// Take the expired timers out first, so timers rescheduled while firing wait for the next call
+		std::vector<_TimerPtr> Due;
+		while (!Heap.empty() && Heap.front()->Data.Deadline <= aNow)
+		{
+			_Timer & Expired = *Heap.front();
+			Erase(0);
+			Expired.Data.State = TimerState::Firing;
+			Due.push_back(*Expired.Data.Position);
+		}
+
+		std::size_t Triggered = 0;
+		for (_TimerPtr & Expired : Due)
+		{
+			while (Expired->Data.State == TimerState::Firing)
+			{ // Fire outside of the lock, so the slots are free to change the timer. A looping timer already holds its
+			  // next interval, so pausing it from a slot does not leave it due.
+				Expired->Watch = Expired->Looping ? Expired->Interval : Time(0);
+
+#ifndef EL_NO_THREADSAFETY_CHECKS
+				lock.unlock();
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+				Expired->OnTrigger();
+				Triggered++;
+
+#ifndef EL_NO_THREADSAFETY_CHECKS
+				lock.lock();
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+				if (Expired->Data.State != TimerState::Firing)
+					break; // Rescheduled, paused or deleted while firing
+
+				if (!Expired->Looping)
+				{ // Finished
+					Expired->Data.State = TimerState::Removed;
+					Timers.erase(Expired->Data.Position);
+					break;
+				}
+
+				// Continue from the previous deadline, catching up on every interval that passed
+				Expired->Data.Deadline += Expired->Interval;
+				if (Expired->Data.Deadline > aNow || Expired->Interval <= Time(0))
+				{
+					Push(*Expired);
+				}
+			}
+		}
+
+		return Triggered;
+	}
+
+	std::size_t Count() const
+	{ // Returns the number of timers, including paused ones
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(TimersMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		return Timers.size();
+	}
+
+private:
+	Time GetTimeLeft(const _Timer & aTimer) const
+	{ // Scheduled timers only store their deadline
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(TimersMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		if (aTimer.Data.State != TimerState::Scheduled)
+			return aTimer.Watch;
+		return aTimer.Data.Deadline - Clock::now();
+	}
+
+	void Reschedule(_Timer & aTimer)
+	{ // Sets a new deadline from the time left, or takes the timer out of the heap when paused
+		const TimePoint Now = Clock::now();
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(TimersMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		if (aTimer.Data.State == TimerState::Removed)
+			return; // Timers that were removed stay removed
+
+		if (aTimer.Data.State == TimerState::Scheduled)
+			Erase(aTimer.Data.HeapIndex);
+
+		if (aTimer.Paused)
+		{
+			aTimer.Data.State = TimerState::Parked;
+			return;
+		}
+
+		aTimer.Data.Deadline = Now + aTimer.Watch;
+		Push(aTimer);
+	}
+
+	void Push(_Timer & aTimer)
+	{
+		aTimer.Data.State     = TimerState::Scheduled;
+		aTimer.Data.HeapIndex = Heap.size();
+		Heap.push_back(&aTimer);
+		SiftUp(Heap.size() - 1);
+	}
+
+	void Erase(std::size_t aIndex)
+	{ // Removes the entry at the given index, by moving the last entry in its place
+		const std::size_t Last = Heap.size() - 1;
+		if (aIndex != Last)
+		{
+			Swap(aIndex, Last);
+			Heap.pop_back();
+			SiftDown(aIndex);
+			SiftUp(aIndex);
+		}
+		else
+		{
+			Heap.pop_back();
+		}
+	}
+
+	void SiftUp(std::size_t aIndex)
+	{
+		while (aIndex > 0)
+		{
+			const std::size_t Parent = (aIndex - 1) / 2;
+			if (!(Heap[aIndex]->Data.Deadline < Heap[Parent]->Data.Deadline))
+				break;
+			Swap(aIndex, Parent);
+			aIndex = Parent;
+		}
+	}
+
+	void SiftDown(std::size_t aIndex)
+	{
+		for (;;)
+		{
+			const std::size_t Left     = aIndex * 2 + 1;
+			const std::size_t Right    = Left + 1;
+			std::size_t       Smallest = aIndex;
+			if (Left < Heap.size() && Heap[Left]->Data.Deadline < Heap[Smallest]->Data.Deadline)
+				Smallest = Left;
+			if (Right < Heap.size() && Heap[Right]->Data.Deadline < Heap[Smallest]->Data.Deadline)
+				Smallest = Right;
+			if (Smallest == aIndex)
+				break;
+			Swap(aIndex, Smallest);
+			aIndex = Smallest;
+		}
+	}
+
+	void Swap(std::size_t aFirst, std::size_t aSecond)
+	{
+		std::swap(Heap[aFirst], Heap[aSecond]);
+		Heap[aFirst]->Data.HeapIndex  = aFirst;
+		Heap[aSecond]->Data.HeapIndex = aSecond;
+	}
+
+private:
+	std::list<_TimerPtr>  Timers; // Owns all timers, including paused ones
+	std::vector<_Timer *> Heap;   // Scheduled timers, ordered by deadline
+#ifndef EL_NO_THREADSAFETY_CHECKS
+	mutable std::mutex TimersMutex;
+#endif // EL_NO_THREADSAFETY_CHECKS
+};
+
+} // namespace el
@@ -14,7 +14,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <list>
+#include <string>
 
 #ifndef EL_NO_THREADSAFETY_CHECKS
 #include <mutex>
@@ -26,6 +28,8 @@
 
 #include "Connection.hpp"
 #include "Delegate.hpp"
+#include "Instrumentation.hpp"
+#include "Tracing.hpp"
 
 namespace el
 {
@@ -49,6 +53,9 @@ class Event<R(Args...), GroupType>
 	{
 		Connection             connection;
 		std::shared_ptr<_Slot> slot;
+#ifdef EL_ENABLE_INSTRUMENTATION
+		std::shared_ptr<Instrumentation::SlotCounters> counters;
+#endif // EL_ENABLE_INSTRUMENTATION
 	};
 
 public:
@@ -64,9 +71,31 @@ public:
 		UngroupedFrontSlots = aOther.UngroupedFrontSlots;
 		UngroupedBackSlots  = aOther.UngroupedBackSlots;
 #ifndef EL_DISABLE_GROUPING
-		GroupedSlots = GroupedSlots;
+		GroupedSlots = aOther.GroupedSlots;
 #endif // EL_DISABLE_GROUPING
 		bool Enabled = aOther.Enabled;
+#ifndef EL_DISABLE_TRACING
+		TraceName = aOther.TraceName;
+#endif // EL_DISABLE_TRACING
+#ifdef EL_ENABLE_INSTRUMENTATION
+		// The copied entries still count towards the other event, give them counters of their own
+		for (Entry & entry : UngroupedFrontSlots)
+			entry.counters = Stats.AddSlot(entry.connection);
+#ifndef EL_DISABLE_GROUPING
+		for (auto & Pair : GroupedSlots)
+		{
+			for (Entry & entry : Pair.second)
+				entry.counters = Stats.AddSlot(entry.connection);
+		}
+#endif // EL_DISABLE_GROUPING
+		for (Entry & entry : UngroupedBackSlots)
+			entry.counters = Stats.AddSlot(entry.connection);
+#endif // EL_ENABLE_INSTRUMENTATION
+	}
+
+	explicit Event(const std::string & aName)
+	{
+		SetName(aName);
 	}
 
 	template <typename Callable>
@@ -80,9 +109,9 @@ public:
 #endif // EL_NO_THREADSAFETY_CHECKS
 
 		if (aLocation == Location::Front)
-			UngroupedFrontSlots.push_front(Entry{ connection, Slot });
+			UngroupedFrontSlots.push_front(MakeEntry(connection, Slot));
 		else
-			UngroupedBackSlots.push_back(Entry{ connection, Slot });
+			UngroupedBackSlots.push_back(MakeEntry(connection, Slot));
 		return connection;
 	}
 
@@ -109,9 +138,9 @@ public:
 		}
 
 		if (aLocation == Location::Front)
-			GroupedSlots[aGroup].push_back(Entry{ connection, Slot });
+			GroupedSlots[aGroup].push_back(MakeEntry(connection, Slot));
 		else
-			GroupedSlots[aGroup].push_back(Entry{ connection, Slot });
+			GroupedSlots[aGroup].push_back(MakeEntry(connection, Slot));
 		return connection;
 	}
 #endif // EL_DISABLE_GROUPING
@@ -140,6 +169,22 @@ public:
 #endif // EL_DISABLE_GROUPING
 	}
 
+	void SetName(const std::string & aName)
+	{ // The name is used to tell events apart in traces, so it is not kept when tracing is disabled
+#ifndef EL_DISABLE_TRACING
+		TraceName = Tracer::Shared().Intern(aName);
+#else
+		(void)aName;
+#endif // EL_DISABLE_TRACING
+	}
+
+#ifndef EL_DISABLE_TRACING
+	const char * GetName() const
+	{
+		return TraceName;
+	}
+#endif // EL_DISABLE_TRACING
+
 	void Enable()
 	{ // Sets the event to enabled
 		Enabled = true;
@@ -172,11 +217,36 @@ public:
 		if (!Enabled)
 			return;
 
-		auto RunThrough = [&aArguments...](std::list<Entry> & aEntryList) {
+#ifdef EL_ENABLE_INSTRUMENTATION
+		Instrumentation::Dispatch Measurement(Stats);
+#endif // EL_ENABLE_INSTRUMENTATION
+
+#ifndef EL_DISABLE_TRACING
+		const TraceSpan DispatchSpan("Event", TraceName);
+#endif // EL_DISABLE_TRACING
+
+		auto RunThrough = [&](std::list<Entry> & aEntryList, std::int64_t aGroup) {
+#ifdef EL_DISABLE_TRACING
+			(void)aGroup; // Only traced
+#endif // EL_DISABLE_TRACING
 			std::for_each(aEntryList.begin(), aEntryList.end(), [&](Entry & aEntry) {
 				if (aEntry.connection.Connected() && !aEntry.connection.Blocking())
 				{ /* Connection is not blocked*/
+#ifndef EL_DISABLE_TRACING
+					const TraceSpan SlotSpan(DispatchSpan.IsActive(), "Slot", TraceName,
+					                         reinterpret_cast<std::uintptr_t>(aEntry.slot.get()), aGroup);
+#endif // EL_DISABLE_TRACING
+#ifdef EL_ENABLE_INSTRUMENTATION
+					const Instrumentation::Clock::time_point Begin = Instrumentation::Clock::now();
 					(*aEntry.slot)(std::forward<Args>(aArguments)...);
+					Measurement.SlotInvoked(*aEntry.counters, Begin);
+				}
+				else
+				{
+					Measurement.SlotSkipped();
+#else
+					(*aEntry.slot)(std::forward<Args>(aArguments)...);
+#endif // EL_ENABLE_INSTRUMENTATION
 				}
 			});
 		};
@@ -197,18 +267,37 @@ public:
 #endif // EL_NO_THREADSAFETY_CHECKS
 
 		// First execute ungrouped slots which were inserted at the front
-		RunThrough(FrontListCopy);
+		RunThrough(FrontListCopy, -1);
 
 #ifndef EL_DISABLE_GROUPING
 		// Execute grouped entries, the map keeps them sorted
 		for (auto & GroupPair : MapCopy)
 		{ // Loop over all lists in the map
-			RunThrough(GroupPair.second);
+			RunThrough(GroupPair.second, detail::TraceGroup(GroupPair.first));
 		}
 #endif // EL_DISABLE_GROUPING
 
 		// And lastly execute ungrouped slots inserted at the back
-		RunThrough(BackListCopy);
+		RunThrough(BackListCopy, -1);
+	}
+
+#ifdef EL_ENABLE_INSTRUMENTATION
+	Instrumentation & GetInstrumentation()
+	{ // Returns the dispatch counters of this event
+		return Stats;
+	}
+#endif // EL_ENABLE_INSTRUMENTATION
+
+private:
+	Entry MakeEntry(const Connection & aConnection, const std::shared_ptr<_Slot> & aSlot)
+	{
+		Entry entry;
+		entry.connection = aConnection;
+		entry.slot       = aSlot;
+#ifdef EL_ENABLE_INSTRUMENTATION
+		entry.counters = Stats.AddSlot(aConnection);
+#endif // EL_ENABLE_INSTRUMENTATION
+		return entry;
 	}
 
 private:
@@ -218,6 +307,12 @@ private:
 	std::map<GroupType, std::list<Entry>> GroupedSlots;
 #endif // EL_DISABLE_GROUPING
 	bool Enabled = true;
+#ifndef EL_DISABLE_TRACING
+	const char * TraceName = "Event"; // Interned by the tracer, so it stays valid while spans refer to it
+#endif // EL_DISABLE_TRACING
+#ifdef EL_ENABLE_INSTRUMENTATION
+	Instrumentation Stats;
+#endif // EL_ENABLE_INSTRUMENTATION
 #ifndef EL_NO_THREADSAFETY_CHECKS
 	std::mutex SlotsMutex;
 #endif // EL_NO_THREADSAFETY_CHECKS
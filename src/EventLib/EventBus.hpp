@@ -0,0 +1,125 @@
+#pragma region Copyright (c) 2017 Hielke Morsink
+/*****************************************************************************
+ * EventLib, a C++ library to provide classes for event-based programming.
+ *
+ * EventLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#include "Connection.hpp"
+#include "Event.hpp"
+
+namespace el
+{
+
+namespace detail
+{
+
+template <typename T>
+struct AlwaysFalse : std::false_type
+{
+};
+
+// Position of T in the pack, known at compile time
+template <typename T, typename... Ts>
+struct IndexOf
+{
+	static_assert(AlwaysFalse<T>::value, "Type is not a message type of this EventBus");
+};
+
+template <typename T, typename... Ts>
+struct IndexOf<T, T, Ts...> : std::integral_constant<std::size_t, 0>
+{
+};
+
+template <typename T, typename U, typename... Ts>
+struct IndexOf<T, U, Ts...> : std::integral_constant<std::size_t, 1 + IndexOf<T, Ts...>::value>
+{
+};
+
+template <typename T, typename... Ts>
+struct Contains : std::false_type
+{
+};
+
+template <typename T, typename U, typename... Ts>
+struct Contains<T, U, Ts...> : std::integral_constant<bool, std::is_same<T, U>::value || Contains<T, Ts...>::value>
+{
+};
+
+template <typename... Ts>
+struct AllUnique : std::true_type
+{
+};
+
+template <typename T, typename... Ts>
+struct AllUnique<T, Ts...> : std::integral_constant<bool, !Contains<T, Ts...>::value && AllUnique<Ts...>::value>
+{
+};
+
+} // namespace detail
+
+// Publisher keyed by message type instead of by value, so every message type can have its own arguments. Each type
+// gets an event of its own, which is found by the position of the type in the list at compile time, so publishing
+// does not involve any lookup, hashing or RTTI. Publishing a type that is not in the list does not compile.
+template <typename... Types>
+class EventBus
+{
+	static_assert(detail::AllUnique<Types...>::value, "Every message type can only be in an EventBus once");
+
+	template <typename T>
+	using _Event = Event<void(const T &)>;
+
+public:
+	template <typename T>
+	static constexpr std::size_t TypeId()
+	{ // Returns the index of the message type, which is the position in the list of types
+		return detail::IndexOf<T, Types...>::value;
+	}
+
+	template <typename T, typename Callable>
+	Connection Subscribe(const Callable & aSlot, Location aLocation = Back)
+	{ // Connect a slot that gets called for every message of type T
+		return GetEvent<T>().Connect(aSlot, aLocation);
+	}
+
+	template <typename T>
+	void Unsubscribe(const Connection & aConnection)
+	{ // Remove a slot that was subscribed to messages of type T
+		GetEvent<T>().Disconnect(aConnection);
+	}
+
+	template <typename T>
+	void Publish(const T & aMessage)
+	{ // Calls all slots subscribed to the type of the message
+		GetEvent<T>()(aMessage);
+	}
+
+	template <typename T>
+	void operator()(const T & aMessage)
+	{
+		Publish(aMessage);
+	}
+
+	template <typename T>
+	_Event<T> & GetEvent()
+	{ // Returns the event of a message type, for what is not wrapped by the bus, like groups
+		return std::get<TypeId<T>()>(Events);
+	}
+
+private:
+	std::tuple<_Event<Types>...> Events;
+};
+
+} // namespace el
@@ -0,0 +1,345 @@
+#pragma region Copyright (c) 2017 Hielke Morsink
+/*****************************************************************************
+ * EventLib, a C++ library to provide classes for event-based programming.
+ *
+ * EventLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Connection.hpp"
+#include "Event.hpp"
+#include "PackedArgs.hpp"
+#include "Publisher.hpp"
+
+namespace el
+{
+
+namespace detail
+{
+
+// Layout shared by the recorder and the replayer. The header takes up a whole (large) page so that chunks of records
+// can be mapped on their own, and every record starts with the time it was recorded at, which stays zero until the
+// record has been written completely.
+template <typename... Ts>
+struct EventLogFormat
+{
+	static constexpr std::uint32_t MagicNumber     = 0x454C524C; // "ELRL"
+	static constexpr std::size_t   HeaderSize      = 65536;
+	static constexpr std::size_t   RecordsPerChunk = 65536;
+	static constexpr std::size_t   MaxChunks       = 4096;
+
+	struct Header
+	{
+		std::uint32_t Magic;
+		std::uint32_t RecordSize;
+	};
+
+	struct Record
+	{
+		std::atomic<std::uint64_t> Timestamp; // Nanoseconds since the recording started, plus one
+		PackedArgs<Ts...>          Message;
+	};
+
+	static_assert(AllTriviallyCopyable<Ts...>::value, "Logged arguments must be trivially copyable");
+	static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Logging requires lock-free atomics");
+
+	static constexpr std::size_t ChunkSize = RecordsPerChunk * sizeof(Record);
+};
+
+} // namespace detail
+
+// Appends invocations to a binary log file that is mapped into memory in chunks, so recording is a copy into mapped
+// memory without a system call. Arguments are stored as they are in memory, which is why they need to be trivially
+// copyable, and the log can only be replayed by a build with the same types. Recording from multiple threads is
+// supported, records are stored in the order in which they claimed their place in the log.
+template <typename... Ts>
+class EventRecorder
+{
+	using _Format = detail::EventLogFormat<Ts...>;
+	using _Record = typename _Format::Record;
+	using Clock   = std::chrono::steady_clock;
+
+public:
+	explicit EventRecorder(const std::string & aPath)
+	    : Path(aPath)
+	{ // Creates the log file, replacing an existing one
+		Descriptor = open(aPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (Descriptor < 0)
+			throw std::system_error(errno, std::generic_category(), "EventRecorder open failed for " + aPath);
+
+		typename _Format::Header Header{ _Format::MagicNumber, static_cast<std::uint32_t>(sizeof(_Record)) };
+		if (pwrite(Descriptor, &Header, sizeof(Header), 0) != static_cast<ssize_t>(sizeof(Header)))
+			Fail("header write", errno);
+
+		for (std::atomic<char *> & Chunk : Chunks)
+			Chunk.store(nullptr, std::memory_order_relaxed);
+		Start = Clock::now();
+	}
+
+	EventRecorder(const EventRecorder &) = delete;
+	EventRecorder & operator=(const EventRecorder &) = delete;
+
+	~EventRecorder()
+	{ // Unmaps the chunks and cuts off the space that was reserved but not used, call Close to know if that worked
+		Close();
+	}
+
+	void Record(Ts... aArguments)
+	{ // Appends a record, which is dropped when the log is full
+		const std::uint64_t Index = NextIndex.fetch_add(1, std::memory_order_relaxed);
+		const std::size_t   Chunk = static_cast<std::size_t>(Index / _Format::RecordsPerChunk);
+		if (Chunk >= _Format::MaxChunks)
+		{
+			Dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		char * Base = Chunks[Chunk].load(std::memory_order_acquire);
+		if (Base == nullptr)
+			Base = MapChunk(Chunk);
+
+		_Record & Target = reinterpret_cast<_Record *>(Base)[Index % _Format::RecordsPerChunk];
+		detail::PackArgs(Target.Message, std::forward<Ts>(aArguments)...);
+
+		const auto Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - Start).count();
+		Target.Timestamp.store(static_cast<std::uint64_t>(Elapsed) + 1, std::memory_order_release);
+	}
+
+	void operator()(Ts... aArguments)
+	{
+		Record(std::forward<Ts>(aArguments)...);
+	}
+
+	Connection Attach(Event<void(Ts...)> & aEvent)
+	{ // Records every invocation of the event, until the connection gets disconnected
+		Connection connection =
+		    aEvent.Connect([this](Ts... aArguments) { Record(std::forward<Ts>(aArguments)...); }, Front);
+		Attached.push_back(connection);
+		return connection;
+	}
+
+	template <typename Key, typename... Args>
+	Connection Attach(Publisher<Key, Args...> & aPublisher, const Key & aKey)
+	{ // Records every message published with the given key, the recorder has to be made for <Key, Args...>
+		static_assert(std::is_same<Publisher<Key, Args...>, Publisher<Ts...>>::value, "Recorder types do not match");
+		Connection connection = aPublisher.Register(
+		    aKey, [this, aKey](Args... aArguments) { Record(aKey, std::forward<Args>(aArguments)...); }, Front);
+		Attached.push_back(connection);
+		return connection;
+	}
+
+	std::uint64_t GetRecordCount() const
+	{ // Returns how many records were appended, not counting dropped ones
+		const std::uint64_t Claimed = NextIndex.load(std::memory_order_relaxed);
+		const std::uint64_t Limit   = std::uint64_t(_Format::MaxChunks) * _Format::RecordsPerChunk;
+		return Claimed < Limit ? Claimed : Limit;
+	}
+
+	std::uint64_t GetDroppedCount() const
+	{ // Returns how many records did not fit in the log
+		return Dropped.load(std::memory_order_relaxed);
+	}
+
+	bool Close()
+	{ // Disconnects from attached events and finishes the log, recording must have stopped on all threads. Returns
+	  // false when the reserved space could not be cut off, the log is still readable because replaying stops at the
+	  // first record that was not written.
+		for (Connection & connection : Attached)
+			connection.Disconnect();
+		Attached.clear();
+
+		if (Descriptor < 0)
+			return true;
+
+		for (std::atomic<char *> & Chunk : Chunks)
+		{
+			if (char * Base = Chunk.exchange(nullptr))
+				munmap(Base, _Format::ChunkSize);
+		}
+		const std::uint64_t Used = _Format::HeaderSize + GetRecordCount() * sizeof(_Record);
+		const bool          Truncated = ftruncate(Descriptor, static_cast<off_t>(Used)) == 0;
+		close(Descriptor);
+		Descriptor = -1;
+		return Truncated;
+	}
+
+private:
+	char * MapChunk(std::size_t aChunk)
+	{ // Grows the file and maps the chunk, the first thread that needs it does the work
+		std::lock_guard<std::mutex> Lock(ChunkMutex);
+		char *                      Base = Chunks[aChunk].load(std::memory_order_relaxed);
+		if (Base != nullptr)
+			return Base;
+
+		const off_t Offset = static_cast<off_t>(_Format::HeaderSize + aChunk * _Format::ChunkSize);
+		if (Offset + static_cast<off_t>(_Format::ChunkSize) > FileSize)
+		{
+			FileSize = Offset + static_cast<off_t>(_Format::ChunkSize);
+			if (ftruncate(Descriptor, FileSize) != 0)
+				throw std::system_error(errno, std::generic_category(), "EventRecorder ftruncate failed for " + Path);
+		}
+
+		void * Address = mmap(nullptr, _Format::ChunkSize, PROT_READ | PROT_WRITE, MAP_SHARED, Descriptor, Offset);
+		if (Address == MAP_FAILED)
+			throw std::system_error(errno, std::generic_category(), "EventRecorder mmap failed for " + Path);
+
+		Base = static_cast<char *>(Address);
+		Chunks[aChunk].store(Base, std::memory_order_release);
+		return Base;
+	}
+
+	[[noreturn]] void Fail(const char * aWhat, int aError)
+	{ // Releases the file, as the destructor will not run
+		close(Descriptor);
+		throw std::system_error(aError, std::generic_category(), std::string("EventRecorder ") + aWhat + " for " + Path);
+	}
+
+private:
+	std::string                Path;
+	int                        Descriptor = -1;
+	off_t                      FileSize   = 0;
+	Clock::time_point          Start;
+	std::atomic<std::uint64_t> NextIndex{ 0 };
+	std::atomic<std::uint64_t> Dropped{ 0 };
+	std::atomic<char *>        Chunks[_Format::MaxChunks];
+	std::mutex                 ChunkMutex;
+	std::vector<Connection>    Attached;
+};
+
+// Reads a log written by EventRecorder<Ts...>, and calls a target with the recorded arguments. The target can be an
+// Event, a Publisher (with the key as the first type) or any other callable. Replaying at the original speed keeps
+// the recorded time between invocations, which makes a recording usable as a realistic load for benchmarks.
+template <typename... Ts>
+class EventReplayer
+{
+	using _Format = detail::EventLogFormat<Ts...>;
+	using _Record = typename _Format::Record;
+	using Clock   = std::chrono::steady_clock;
+
+public:
+	explicit EventReplayer(const std::string & aPath)
+	{ // Maps the whole log
+		const int Descriptor = open(aPath.c_str(), O_RDONLY);
+		if (Descriptor < 0)
+			throw std::system_error(errno, std::generic_category(), "EventReplayer open failed for " + aPath);
+
+		struct stat Status;
+		if (fstat(Descriptor, &Status) != 0 || static_cast<std::size_t>(Status.st_size) < _Format::HeaderSize)
+		{
+			const int Error = errno != 0 ? errno : EINVAL;
+			close(Descriptor);
+			throw std::system_error(Error, std::generic_category(), "EventReplayer log is too small: " + aPath);
+		}
+
+		Size           = static_cast<std::size_t>(Status.st_size);
+		void * Address = mmap(nullptr, Size, PROT_READ, MAP_SHARED, Descriptor, 0);
+		const int Error = errno;
+		close(Descriptor);
+		if (Address == MAP_FAILED)
+			throw std::system_error(Error, std::generic_category(), "EventReplayer mmap failed for " + aPath);
+		Base = static_cast<const char *>(Address);
+
+		typename _Format::Header Header;
+		std::memcpy(&Header, Base, sizeof(Header));
+		if (Header.Magic != _Format::MagicNumber || Header.RecordSize != sizeof(_Record))
+		{
+			munmap(const_cast<char *>(Base), Size);
+			throw std::system_error(EINVAL, std::generic_category(), "EventReplayer log does not match its types: " + aPath);
+		}
+
+		// Records that were claimed but never written end the log
+		const std::size_t Capacity = (Size - _Format::HeaderSize) / sizeof(_Record);
+		while (Count < Capacity && Records()[Count].Timestamp.load(std::memory_order_acquire) != 0)
+			Count++;
+	}
+
+	EventReplayer(const EventReplayer &) = delete;
+	EventReplayer & operator=(const EventReplayer &) = delete;
+
+	~EventReplayer()
+	{
+		munmap(const_cast<char *>(Base), Size);
+	}
+
+	std::size_t GetRecordCount() const
+	{
+		return Count;
+	}
+
+	std::chrono::nanoseconds GetDuration() const
+	{ // Returns the time between the start of the recording and the last record
+		return Count == 0 ? std::chrono::nanoseconds(0) : Timestamp(Count - 1);
+	}
+
+	template <typename Target>
+	std::size_t Replay(Target && aTarget, double aSpeed = 0)
+	{ // Calls the target for every record. A speed of 1 keeps the recorded timing, 2 replays twice as fast, and 0
+	  // replays as fast as possible. Returns how many records were replayed.
+		const Clock::time_point Start = Clock::now();
+		for (std::size_t i = 0; i < Count; i++)
+		{
+			if (aSpeed > 0)
+			{
+				const auto Offset = std::chrono::duration_cast<Clock::duration>(Timestamp(i) / aSpeed);
+				std::this_thread::sleep_until(Start + Offset);
+			}
+			Deliver(aTarget, Records()[i].Message, std::index_sequence_for<Ts...>());
+		}
+		return Count;
+	}
+
+private:
+	const _Record * Records() const
+	{
+		return reinterpret_cast<const _Record *>(Base + _Format::HeaderSize);
+	}
+
+	std::chrono::nanoseconds Timestamp(std::size_t aIndex) const
+	{
+		return std::chrono::nanoseconds(Records()[aIndex].Timestamp.load(std::memory_order_relaxed) - 1);
+	}
+
+	template <typename Target, std::size_t... Indices>
+	static void Deliver(Target & aTarget, const detail::PackedArgs<Ts...> & aMessage, std::index_sequence<Indices...>)
+	{ // Arguments are passed as copies, so targets can take them by value or by (const) reference
+		detail::PackedArgs<Ts...> Message = aMessage;
+		aTarget(detail::PackedGet<Indices>::Get(Message)...);
+	}
+
+private:
+	const char * Base  = nullptr;
+	std::size_t  Size  = 0;
+	std::size_t  Count = 0;
+};
+
+} // namespace el
+
+#endif // defined(__unix__) || defined(__APPLE__)
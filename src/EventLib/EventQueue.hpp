@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <queue>
 
@@ -22,6 +23,7 @@
 
 #include "Connection.hpp"
 #include "Delegate.hpp"
+#include "Tracing.hpp"
 
 namespace el
 {
@@ -57,6 +59,10 @@ public:
 
 	inline void operator()(Args... aArguments)
 	{
+#ifndef EL_DISABLE_TRACING
+		const TraceSpan DrainSpan("EventQueue", "EventQueue");
+#endif // EL_DISABLE_TRACING
+
 #ifndef EL_NO_THREADSAFETY_CHECKS
 		QueueMutex.lock();
 #endif // EL_NO_THREADSAFETY_CHECKS
@@ -72,6 +78,10 @@ public:
 
 			if (entry.connection.Connected())
 			{ // Slot is connected
+#ifndef EL_DISABLE_TRACING
+				const TraceSpan SlotSpan(DrainSpan.IsActive(), "Slot", "EventQueue",
+				                         reinterpret_cast<std::uintptr_t>(entry.slot.get()));
+#endif // EL_DISABLE_TRACING
 				(*entry.slot)(std::forward<Args>(aArguments)...);
 			}
 
@@ -0,0 +1,387 @@
+#pragma region Copyright (c) 2017 Hielke Morsink
+/*****************************************************************************
+ * EventLib, a C++ library to provide classes for event-based programming.
+ *
+ * EventLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+// Dispatch instrumentation is only compiled in when EL_ENABLE_INSTRUMENTATION is defined. Without it, events contain
+// no counters and dispatching does not read the clock.
+#ifdef EL_ENABLE_INSTRUMENTATION
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "Connection.hpp"
+
+namespace el
+{
+
+namespace detail
+{
+
+inline std::uint64_t ThreadId()
+{ // Numbers threads in the order they first dispatch something, unlike std::thread::id these are never reused
+	static std::atomic<std::uint64_t> NextThread(0);
+	thread_local const std::uint64_t  Thread = NextThread++;
+	return Thread;
+}
+
+inline unsigned Log2Bucket(std::uint64_t aValue, unsigned aBucketCount)
+{ // Bucket 0 holds 0, bucket i holds values in [2^(i-1), 2^i), the last bucket holds everything above
+	unsigned Bucket = 0;
+	if (aValue != 0)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		Bucket = 64 - static_cast<unsigned>(__builtin_clzll(aValue));
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long Index;
+		_BitScanReverse64(&Index, aValue);
+		Bucket = static_cast<unsigned>(Index) + 1;
+#else
+		while (aValue != 0)
+		{
+			aValue >>= 1;
+			Bucket++;
+		}
+#endif
+	}
+	return Bucket < aBucketCount ? Bucket : aBucketCount - 1;
+}
+
+inline void Increase(std::atomic<std::uint64_t> & aCounter, std::uint64_t aAmount)
+{ // Only the owning thread writes a counter, so it needs no read-modify-write, other threads only read it
+	aCounter.store(aCounter.load(std::memory_order_relaxed) + aAmount, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+struct DispatchStats
+{
+	std::uint64_t            Dispatches   = 0;
+	std::uint64_t            SlotsInvoked = 0;
+	std::uint64_t            SlotsSkipped = 0; // Blocked or disconnected
+	std::chrono::nanoseconds TimeSpent    = std::chrono::nanoseconds(0);
+};
+
+struct SlotStats
+{
+	static constexpr unsigned BucketCount = 48;
+
+	Connection               connection; // Compare with SharesSlotWith to find the slot
+	std::uint64_t            Id    = 0;  // Slots are numbered in the order they were connected
+	std::uint64_t            Calls = 0;
+	std::chrono::nanoseconds TimeSpent = std::chrono::nanoseconds(0);
+	std::uint64_t            Histogram[BucketCount] = {}; // Calls by log2 of their duration in nanoseconds
+
+	std::chrono::nanoseconds Percentile(double aFraction) const
+	{ // Returns the upper bound of the bucket the given fraction of calls falls in
+		const std::uint64_t Target = static_cast<std::uint64_t>(aFraction * Calls + 0.5);
+		std::uint64_t       Seen   = 0;
+		for (unsigned Bucket = 0; Bucket < BucketCount; Bucket++)
+		{
+			Seen += Histogram[Bucket];
+			if (Seen >= Target && Seen != 0)
+				return std::chrono::nanoseconds(Bucket == 0 ? 0 : (std::int64_t(1) << Bucket) - 1);
+		}
+		return std::chrono::nanoseconds(0);
+	}
+};
+
+// Counters of a single event. Every thread that dispatches the event gets its own counters, which only it writes to,
+// so threads dispatching the same event never write to the same memory. Reading the stats sums the counters of all
+// threads.
+class Instrumentation
+{
+	struct SlotCell
+	{
+		std::atomic<std::uint64_t> Calls{ 0 };
+		std::atomic<std::uint64_t> Nanoseconds{ 0 };
+		std::atomic<std::uint64_t> Histogram[SlotStats::BucketCount] = {};
+	};
+
+	static constexpr std::size_t CellsPerChunk = 16;
+
+	struct ThreadCounters
+	{
+		std::uint64_t              Thread;
+		ThreadCounters *           Next = nullptr;
+		std::atomic<std::uint64_t> Dispatches{ 0 };
+		std::atomic<std::uint64_t> SlotsInvoked{ 0 };
+		std::atomic<std::uint64_t> SlotsSkipped{ 0 };
+		std::atomic<std::uint64_t> Nanoseconds{ 0 };
+
+		// Slot counters by slot index. Only the owning thread adds chunks, and it holds the mutex while doing so.
+		// Readers hold the mutex while reading, the owning thread does not need it to read or count.
+		std::vector<std::unique_ptr<SlotCell[]>> Chunks;
+		std::mutex                               ChunksMutex;
+
+		SlotCell & Cell(std::size_t aIndex)
+		{
+			const std::size_t Chunk = aIndex / CellsPerChunk;
+			if (Chunk >= Chunks.size())
+			{
+				std::lock_guard<std::mutex> Lock(ChunksMutex);
+				while (Chunks.size() <= Chunk)
+					Chunks.emplace_back(new SlotCell[CellsPerChunk]);
+			}
+			return Chunks[Chunk][aIndex % CellsPerChunk];
+		}
+
+		SlotCell * FindCell(std::size_t aIndex)
+		{ // Call with the mutex held
+			const std::size_t Chunk = aIndex / CellsPerChunk;
+			return Chunk < Chunks.size() ? &Chunks[Chunk][aIndex % CellsPerChunk] : nullptr;
+		}
+	};
+
+public:
+	using Clock           = std::chrono::steady_clock;
+	using SlowSlotHandler = std::function<void(const SlotStats &, std::chrono::nanoseconds)>;
+
+	struct SlotCounters
+	{ // Identifies the counters of a slot in every thread
+		Connection    connection;
+		std::uint64_t Id    = 0;
+		std::size_t   Index = 0; // Reused by slots that are connected after this one is gone
+	};
+
+	class Dispatch
+	{ // Counts a single dispatch in the counters of the current thread
+	public:
+		explicit Dispatch(Instrumentation & aOwner)
+		    : Owner(aOwner)
+		    , Counters(aOwner.GetThreadCounters())
+		    , Start(Clock::now())
+		{
+		}
+
+		Dispatch(const Dispatch &) = delete;
+
+		~Dispatch()
+		{
+			const auto Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - Start);
+			detail::Increase(Counters.Dispatches, 1);
+			detail::Increase(Counters.SlotsInvoked, Invoked);
+			detail::Increase(Counters.SlotsSkipped, Skipped);
+			detail::Increase(Counters.Nanoseconds, static_cast<std::uint64_t>(Elapsed.count()));
+		}
+
+		void SlotInvoked(const SlotCounters & aSlot, const Clock::time_point & aBegin)
+		{ // Counts the time since aBegin, which was taken right before the slot was called
+			const auto Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - aBegin);
+			Invoked++;
+			Owner.Record(Counters, aSlot, Elapsed);
+		}
+
+		void SlotSkipped()
+		{
+			Skipped++;
+		}
+
+	private:
+		Instrumentation & Owner;
+		ThreadCounters &  Counters;
+		Clock::time_point Start;
+		std::uint64_t     Invoked = 0;
+		std::uint64_t     Skipped = 0;
+	};
+
+	Instrumentation() = default;
+
+	// Counters belong to a single event, so copies start from zero
+	Instrumentation(const Instrumentation &) = delete;
+
+	~Instrumentation()
+	{
+		ThreadCounters * Counters = Threads.load(std::memory_order_acquire);
+		while (Counters != nullptr)
+		{
+			ThreadCounters * Next = Counters->Next;
+			delete Counters;
+			Counters = Next;
+		}
+	}
+
+	std::shared_ptr<SlotCounters> AddSlot(const Connection & aConnection)
+	{ // Called by the event when a slot gets connected, the event owns the returned counters
+		std::shared_ptr<SlotCounters> Slot = std::make_shared<SlotCounters>();
+		Slot->connection                   = aConnection;
+
+		std::lock_guard<std::mutex> Lock(SlotsMutex);
+		Slot->Id = NextSlotId++;
+
+		// A slot that is gone is not in any dispatch anymore, so its index can be cleared and reused
+		const auto Free = std::find_if(Slots.begin(), Slots.end(),
+		                               [](const std::weak_ptr<SlotCounters> & aSlot) { return aSlot.expired(); });
+		Slot->Index     = static_cast<std::size_t>(Free - Slots.begin());
+		if (Slot->Index == Slots.size())
+			Slots.push_back(Slot);
+		else
+		{
+			Slots[Slot->Index] = Slot;
+			ForEachCell(Slot->Index, [](SlotCell & aCell) { ClearCell(aCell); });
+		}
+		return Slot;
+	}
+
+	DispatchStats GetStats() const
+	{ // Sums the counters of all threads
+		DispatchStats Stats;
+		for (const ThreadCounters * Counters = Threads.load(std::memory_order_acquire); Counters != nullptr;
+		     Counters                        = Counters->Next)
+		{
+			Stats.Dispatches += Counters->Dispatches.load(std::memory_order_relaxed);
+			Stats.SlotsInvoked += Counters->SlotsInvoked.load(std::memory_order_relaxed);
+			Stats.SlotsSkipped += Counters->SlotsSkipped.load(std::memory_order_relaxed);
+			Stats.TimeSpent += std::chrono::nanoseconds(Counters->Nanoseconds.load(std::memory_order_relaxed));
+		}
+		return Stats;
+	}
+
+	std::vector<SlotStats> GetSlotStats() const
+	{ // Returns the counters of every slot that is still in the event, summed over all threads
+		std::vector<SlotStats>      Result;
+		std::lock_guard<std::mutex> Lock(SlotsMutex);
+		for (const std::weak_ptr<SlotCounters> & Slot : Slots)
+		{
+			if (std::shared_ptr<SlotCounters> Counters = Slot.lock())
+				Result.push_back(Snapshot(*Counters));
+		}
+		return Result;
+	}
+
+	void SetSlowSlotHandler(const std::chrono::nanoseconds & aThreshold, const SlowSlotHandler & aHandler)
+	{ // Calls the handler on the dispatching thread, every time a slot took longer than the threshold
+		std::lock_guard<std::mutex> Lock(SlotsMutex);
+		SlowHandler = std::make_shared<SlowSlotHandler>(aHandler);
+		Threshold.store(aHandler ? aThreshold.count() : -1, std::memory_order_relaxed);
+	}
+
+	void Reset()
+	{ // Sets all counters back to zero. Counts made by other threads while this runs can be partly kept.
+		for (ThreadCounters * Counters = Threads.load(std::memory_order_acquire); Counters != nullptr;
+		     Counters                  = Counters->Next)
+		{
+			Counters->Dispatches.store(0, std::memory_order_relaxed);
+			Counters->SlotsInvoked.store(0, std::memory_order_relaxed);
+			Counters->SlotsSkipped.store(0, std::memory_order_relaxed);
+			Counters->Nanoseconds.store(0, std::memory_order_relaxed);
+
+			std::lock_guard<std::mutex> Lock(Counters->ChunksMutex);
+			for (const std::unique_ptr<SlotCell[]> & Chunk : Counters->Chunks)
+			{
+				for (std::size_t i = 0; i < CellsPerChunk; i++)
+					ClearCell(Chunk[i]);
+			}
+		}
+	}
+
+private:
+	ThreadCounters & GetThreadCounters()
+	{ // Only the current thread adds its own counters, so it cannot race with itself to add them twice
+		const std::uint64_t Thread = detail::ThreadId();
+		ThreadCounters *    Head   = Threads.load(std::memory_order_acquire);
+		for (ThreadCounters * Counters = Head; Counters != nullptr; Counters = Counters->Next)
+		{
+			if (Counters->Thread == Thread)
+				return *Counters;
+		}
+
+		ThreadCounters * Counters = new ThreadCounters;
+		Counters->Thread          = Thread;
+		Counters->Next            = Head;
+		while (!Threads.compare_exchange_weak(Counters->Next, Counters, std::memory_order_release,
+		                                      std::memory_order_acquire))
+		{
+		}
+		return *Counters;
+	}
+
+	void Record(ThreadCounters & aCounters, const SlotCounters & aSlot, const std::chrono::nanoseconds & aElapsed)
+	{
+		const std::uint64_t Nanoseconds = static_cast<std::uint64_t>(aElapsed.count());
+		SlotCell &          Cell        = aCounters.Cell(aSlot.Index);
+		detail::Increase(Cell.Calls, 1);
+		detail::Increase(Cell.Nanoseconds, Nanoseconds);
+		detail::Increase(Cell.Histogram[detail::Log2Bucket(Nanoseconds, SlotStats::BucketCount)], 1);
+
+		const std::int64_t Limit = Threshold.load(std::memory_order_relaxed);
+		if (Limit >= 0 && aElapsed.count() > Limit)
+		{ // Slow slots are rare, so only they pay for the lock
+			std::shared_ptr<SlowSlotHandler> Handler;
+			{
+				std::lock_guard<std::mutex> Lock(SlotsMutex);
+				Handler = SlowHandler;
+			}
+			if (Handler && *Handler)
+				(*Handler)(Snapshot(aSlot), aElapsed);
+		}
+	}
+
+	template <typename Callable>
+	void ForEachCell(std::size_t aIndex, const Callable & aFunc) const
+	{ // Calls the function with the counters every thread has for the slot
+		for (ThreadCounters * Counters = Threads.load(std::memory_order_acquire); Counters != nullptr;
+		     Counters                  = Counters->Next)
+		{
+			std::lock_guard<std::mutex> Lock(Counters->ChunksMutex);
+			if (SlotCell * Cell = Counters->FindCell(aIndex))
+				aFunc(*Cell);
+		}
+	}
+
+	static void ClearCell(SlotCell & aCell)
+	{
+		aCell.Calls.store(0, std::memory_order_relaxed);
+		aCell.Nanoseconds.store(0, std::memory_order_relaxed);
+		for (std::atomic<std::uint64_t> & Bucket : aCell.Histogram)
+			Bucket.store(0, std::memory_order_relaxed);
+	}
+
+	SlotStats Snapshot(const SlotCounters & aSlot) const
+	{
+		SlotStats Stats;
+		Stats.connection = aSlot.connection;
+		Stats.Id         = aSlot.Id;
+		ForEachCell(aSlot.Index, [&Stats](const SlotCell & aCell) {
+			Stats.Calls += aCell.Calls.load(std::memory_order_relaxed);
+			Stats.TimeSpent += std::chrono::nanoseconds(aCell.Nanoseconds.load(std::memory_order_relaxed));
+			for (unsigned Bucket = 0; Bucket < SlotStats::BucketCount; Bucket++)
+				Stats.Histogram[Bucket] += aCell.Histogram[Bucket].load(std::memory_order_relaxed);
+		});
+		return Stats;
+	}
+
+private:
+	std::atomic<ThreadCounters *> Threads{ nullptr }; // Only grows, the counters are deleted with the event
+
+	std::vector<std::weak_ptr<SlotCounters>> Slots; // By slot index, owned by the entries of the event
+	std::uint64_t                            NextSlotId = 0;
+	std::shared_ptr<SlowSlotHandler>         SlowHandler;
+	std::atomic<std::int64_t>                Threshold{ -1 }; // Negative when there is no handler
+	mutable std::mutex                       SlotsMutex;
+};
+
+} // namespace el
+
+#endif // EL_ENABLE_INSTRUMENTATION
@@ -0,0 +1,83 @@
+#pragma region Copyright (c) 2017 Hielke Morsink
+/*****************************************************************************
+ * EventLib, a C++ library to provide classes for event-based programming.
+ *
+ * EventLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace el
+{
+
+namespace detail
+{
+
+template <typename... Ts>
+struct AllTriviallyCopyable : std::true_type
+{
+};
+
+template <typename T, typename... Ts>
+struct AllTriviallyCopyable<T, Ts...>
+    : std::integral_constant<bool, std::is_trivially_copyable<T>::value && AllTriviallyCopyable<Ts...>::value>
+{
+};
+
+// Plain aggregate holding a message, trivially copyable as long as all members are
+template <typename... Ts>
+struct PackedArgs
+{
+};
+
+template <typename T, typename... Ts>
+struct PackedArgs<T, Ts...>
+{
+	T                  Head;
+	PackedArgs<Ts...> Tail;
+};
+
+template <std::size_t Index>
+struct PackedGet
+{
+	template <typename T, typename... Ts>
+	static auto & Get(PackedArgs<T, Ts...> & aPacked)
+	{
+		return PackedGet<Index - 1>::Get(aPacked.Tail);
+	}
+};
+
+template <>
+struct PackedGet<0>
+{
+	template <typename T, typename... Ts>
+	static T & Get(PackedArgs<T, Ts...> & aPacked)
+	{
+		return aPacked.Head;
+	}
+};
+
+inline void PackArgs(PackedArgs<> &)
+{
+}
+
+template <typename T, typename... Ts, typename U, typename... Us>
+inline void PackArgs(PackedArgs<T, Ts...> & aPacked, U && aHead, Us &&... aTail)
+{
+	aPacked.Head = std::forward<U>(aHead);
+	PackArgs(aPacked.Tail, std::forward<Us>(aTail)...);
+}
+
+} // namespace detail
+
+} // namespace el
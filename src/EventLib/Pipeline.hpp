@@ -0,0 +1,210 @@
+#pragma region Copyright (c) 2017 Hielke Morsink
+/*****************************************************************************
+ * EventLib, a C++ library to provide classes for event-based programming.
+ *
+ * EventLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Connection.hpp"
+#include "Event.hpp"
+
+namespace el
+{
+
+// Pipelines connect an event to another one through filter and map stages, for example:
+//   Source | Filter(IsValid) | Map(Convert) | Sink(Target);
+// The stages are fused into a single callable at compile time, which gets connected to the source event once. Passing
+// a call through all stages then costs a single dispatch, rather than one for every event in a chain.
+
+namespace detail
+{
+
+template <typename Predicate>
+struct FilterStage
+{
+	Predicate Pred;
+
+	template <typename Next, typename... Ts>
+	void Apply(Next & aNext, Ts &&... aArguments)
+	{ // Arguments are only passed on when the predicate holds
+		if (Pred(static_cast<const Ts &>(aArguments)...))
+			aNext(std::forward<Ts>(aArguments)...);
+	}
+};
+
+template <typename Function>
+struct MapStage
+{
+	Function Func;
+
+	template <typename Next, typename... Ts>
+	void Apply(Next & aNext, Ts &&... aArguments)
+	{ // The result becomes the single argument of the next stage
+		aNext(Func(std::forward<Ts>(aArguments)...));
+	}
+};
+
+template <typename Target>
+struct SinkStage
+{
+	Target * target;
+
+	template <typename... Ts>
+	void operator()(Ts &&... aArguments)
+	{
+		(*target)(std::forward<Ts>(aArguments)...);
+	}
+};
+
+template <typename Stage, typename Next>
+struct FusedStage
+{ // A stage together with everything after it
+	Stage stage;
+	Next  next;
+
+	template <typename... Ts>
+	void operator()(Ts &&... aArguments)
+	{
+		stage.Apply(next, std::forward<Ts>(aArguments)...);
+	}
+};
+
+template <typename Next>
+Next Fuse(Next aNext)
+{
+	return aNext;
+}
+
+template <typename Next, typename Stage, typename... Rest>
+auto Fuse(Next aNext, Stage aStage, Rest... aRest)
+{ // Stages are wrapped from the back, so the first stage ends up on the outside
+	using _Inner = decltype(Fuse(std::move(aNext), std::move(aRest)...));
+	return FusedStage<Stage, _Inner>{ std::move(aStage), Fuse(std::move(aNext), std::move(aRest)...) };
+}
+
+template <typename Next, typename Tuple, std::size_t... Indices>
+auto FuseAll(Next aNext, Tuple && aStages, std::index_sequence<Indices...>)
+{ // Copies the stages out of a tuple that is still used, and moves them out of one that is not
+	return Fuse(std::move(aNext), std::get<Indices>(std::forward<Tuple>(aStages))...);
+}
+
+template <typename T>
+struct IsStage : std::false_type
+{
+};
+
+template <typename Predicate>
+struct IsStage<FilterStage<Predicate>> : std::true_type
+{
+};
+
+template <typename Function>
+struct IsStage<MapStage<Function>> : std::true_type
+{
+};
+
+} // namespace detail
+
+// A source event with the stages added so far, finished by piping it into a sink. A named pipeline is copied when it
+// gets extended or connected, so it can be fanned out into several sinks.
+template <typename Source, typename... Stages>
+class Pipeline
+{
+public:
+	Pipeline(Source & aSource, std::tuple<Stages...> aStages)
+	    : source(&aSource)
+	    , stages(std::move(aStages))
+	{
+	}
+
+	template <typename Stage>
+	Pipeline<Source, Stages..., Stage> Then(Stage aStage) const &
+	{
+		return Pipeline<Source, Stages..., Stage>(*source, std::tuple_cat(stages, std::make_tuple(std::move(aStage))));
+	}
+
+	template <typename Stage>
+	Pipeline<Source, Stages..., Stage> Then(Stage aStage) &&
+	{
+		return Pipeline<Source, Stages..., Stage>(*source,
+		                                          std::tuple_cat(std::move(stages), std::make_tuple(std::move(aStage))));
+	}
+
+	template <typename Target>
+	Connection Into(Target & aTarget, const Location aLocation = Back) const &
+	{ // Connects the fused stages to the source, disconnect the returned connection to take the pipeline down
+		return source->Connect(detail::FuseAll(detail::SinkStage<Target>{ &aTarget }, stages,
+		                                       std::index_sequence_for<Stages...>()),
+		                       aLocation);
+	}
+
+	template <typename Target>
+	Connection Into(Target & aTarget, const Location aLocation = Back) &&
+	{
+		return source->Connect(detail::FuseAll(detail::SinkStage<Target>{ &aTarget }, std::move(stages),
+		                                       std::index_sequence_for<Stages...>()),
+		                       aLocation);
+	}
+
+private:
+	Source *              source;
+	std::tuple<Stages...> stages;
+};
+
+template <typename Predicate>
+detail::FilterStage<typename std::decay<Predicate>::type> Filter(Predicate && aPredicate)
+{ // Only passes calls on for which the predicate returns true
+	return { std::forward<Predicate>(aPredicate) };
+}
+
+template <typename Function>
+detail::MapStage<typename std::decay<Function>::type> Map(Function && aFunction)
+{ // Passes the result of the function on instead of the arguments
+	return { std::forward<Function>(aFunction) };
+}
+
+template <typename Target>
+detail::SinkStage<Target> Sink(Target & aTarget)
+{ // Calls the target, usually another event, at the end of a pipeline
+	return { &aTarget };
+}
+
+template <typename Signature, typename GroupType, typename Stage,
+          typename = typename std::enable_if<detail::IsStage<Stage>::value>::type>
+Pipeline<Event<Signature, GroupType>, Stage> operator|(Event<Signature, GroupType> & aSource, Stage aStage)
+{
+	return Pipeline<Event<Signature, GroupType>, Stage>(aSource, std::make_tuple(std::move(aStage)));
+}
+
+template <typename Source, typename... Stages, typename Stage,
+          typename = typename std::enable_if<detail::IsStage<Stage>::value>::type>
+Pipeline<Source, Stages..., Stage> operator|(Pipeline<Source, Stages...> aPipeline, Stage aStage)
+{
+	return std::move(aPipeline).Then(std::move(aStage));
+}
+
+template <typename Signature, typename GroupType, typename Target>
+Connection operator|(Event<Signature, GroupType> & aSource, detail::SinkStage<Target> aSink)
+{
+	return aSource.Connect(aSink);
+}
+
+template <typename Source, typename... Stages, typename Target>
+Connection operator|(Pipeline<Source, Stages...> aPipeline, detail::SinkStage<Target> aSink)
+{
+	return std::move(aPipeline).Into(*aSink.target);
+}
+
+} // namespace el
@@ -70,6 +70,18 @@ public:
 		Publish(aKey, std::forward<Args>(aArguments)...);
 	}
 
+#ifdef EL_ENABLE_INSTRUMENTATION
+	Instrumentation * GetInstrumentation(const Key & aKey)
+	{ // Returns the dispatch counters of a topic, or nullptr when nothing was registered to it
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(MapMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+		auto it = Map.find(aKey);
+		return it == Map.end() ? nullptr : &it->second.GetInstrumentation();
+	}
+#endif // EL_ENABLE_INSTRUMENTATION
+
 private:
 	std::unordered_map<Key, Event<void(Args...)>> Map;
 #ifndef EL_NO_THREADSAFETY_CHECKS
@@ -0,0 +1,287 @@
+#pragma region Copyright (c) 2017 Hielke Morsink
+/*****************************************************************************
+ * EventLib, a C++ library to provide classes for event-based programming.
+ *
+ * EventLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifndef EL_NO_THREADSAFETY_CHECKS
+#include <mutex>
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+#include "Connection.hpp"
+#include "Event.hpp"
+#include "Timer.hpp"
+
+namespace el
+{
+
+namespace detail
+{
+
+// Shared part of the rate limiting adapters. It connects to the source event and owns a single looping timer, which
+// is created up front and paused while there is nothing to do. Only the latest arguments are kept. The source can be
+// called from any thread: calls only change the adapter's state, and leave a request to resume or restart the timer
+// that the thread updating the timers picks up at the start of its next update.
+template <typename Time, typename... Args>
+class LatestArguments
+{
+protected:
+	using _Values = std::tuple<typename std::decay<Args>::type...>;
+	using _Timer  = Timer<Time>;
+
+	LatestArguments(TimerManager<Time> & aManager, const Time & aInterval)
+	    : Interval(aInterval)
+	    , timer(aManager.Create(aInterval, true))
+	{
+		timer->Pause();
+		UpdateConnection = aManager.OnUpdate.Connect([this]() { ApplyRequest(); });
+	}
+
+	LatestArguments(const LatestArguments &) = delete;
+
+	~LatestArguments()
+	{ // Stop receiving calls, updates and timer triggers before the adapter is gone
+		SourceConnection.Disconnect();
+		UpdateConnection.Disconnect();
+		TriggerConnection.Disconnect();
+		timer->Delete();
+	}
+
+	template <typename Source, typename OnCall, typename OnTrigger>
+	void Connect(Source & aSource, const OnCall & aOnCall, const OnTrigger & aOnTrigger)
+	{
+		SourceConnection  = aSource.Connect(aOnCall);
+		TriggerConnection = timer->OnTrigger.Connect(aOnTrigger);
+	}
+
+	template <typename... Ts>
+	void Store(Ts &&... aArguments)
+	{
+		Latest  = _Values(std::forward<Ts>(aArguments)...);
+		Pending = true;
+	}
+
+	void Request(bool aRestart)
+	{ // Call with the lock held, the timer resumes (from the start) at the beginning of the next update
+		Restart = Restart || aRestart;
+		Requested.store(true, std::memory_order_release);
+	}
+
+	void ApplyRequest()
+	{ // Runs on the updating thread, which is the only one that touches the timer
+		if (!Requested.load(std::memory_order_acquire))
+			return;
+
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(StateMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		if (Restart)
+			timer->Reset();
+		timer->Resume();
+		Restart = false;
+		Requested.store(false, std::memory_order_relaxed);
+	}
+
+	void Emit(_Values & aValues)
+	{ // Called without holding the lock, so slots are free to call into the adapter
+		Emit(aValues, std::index_sequence_for<Args...>());
+	}
+
+	template <std::size_t... Indices>
+	void Emit(_Values & aValues, std::index_sequence<Indices...>)
+	{
+		Output(std::get<Indices>(aValues)...);
+	}
+
+public:
+	Event<void(Args...)> Output; // Called at a bounded rate
+
+protected:
+	Time                    Interval;
+	std::shared_ptr<_Timer> timer;
+	_Values                 Latest;
+	bool                    Pending = false;
+	bool                    Restart = false;
+	std::atomic<bool>       Requested{ false }; // Only set or cleared with the lock held
+	Connection              SourceConnection;
+	Connection              UpdateConnection;
+	Connection              TriggerConnection;
+#ifndef EL_NO_THREADSAFETY_CHECKS
+	std::mutex StateMutex;
+#endif // EL_NO_THREADSAFETY_CHECKS
+};
+
+} // namespace detail
+
+template <typename Signature, typename Time>
+class Throttle;
+
+template <typename Signature, typename Time>
+class Debounce;
+
+template <typename Signature, typename Time>
+class Sample;
+
+// Passes the first call through right away, then at most one call per interval: the latest call made during an
+// interval is passed on when the interval ends.
+template <typename... Args, typename Time>
+class Throttle<void(Args...), Time> : public detail::LatestArguments<Time, Args...>
+{
+	using _Base   = detail::LatestArguments<Time, Args...>;
+	using _Values = typename _Base::_Values;
+
+public:
+	Throttle(Event<void(Args...)> & aSource, TimerManager<Time> & aManager, const Time & aInterval)
+	    : _Base(aManager, aInterval)
+	{
+		this->Connect(aSource, [this](Args... aArguments) { OnCall(std::forward<Args>(aArguments)...); },
+		              [this]() { OnTrigger(); });
+	}
+
+private:
+	void OnCall(Args... aArguments)
+	{
+		{
+#ifndef EL_NO_THREADSAFETY_CHECKS
+			std::lock_guard<std::mutex> Lock(this->StateMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+			if (Open)
+			{ // Within an interval, keep the call for when it ends
+				this->Store(std::forward<Args>(aArguments)...);
+				return;
+			}
+			Open = true;
+			this->Request(true);
+		}
+		this->Output(std::forward<Args>(aArguments)...);
+	}
+
+	void OnTrigger()
+	{ // The interval has ended, the looping timer starts the next one
+		_Values Values;
+		{
+#ifndef EL_NO_THREADSAFETY_CHECKS
+			std::lock_guard<std::mutex> Lock(this->StateMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+			if (!this->Pending)
+			{ // Nothing happened during the last interval, the next call can go through right away
+				if (!this->Requested.load(std::memory_order_relaxed))
+				{ // Unless a call just went through, and its interval is about to start
+					Open = false;
+					this->timer->Pause();
+				}
+				return;
+			}
+			Values        = std::move(this->Latest);
+			this->Pending = false;
+		}
+		this->Emit(Values);
+	}
+
+private:
+	bool Open = false;
+};
+
+// Passes on the latest call once no calls were made for the interval.
+template <typename... Args, typename Time>
+class Debounce<void(Args...), Time> : public detail::LatestArguments<Time, Args...>
+{
+	using _Base   = detail::LatestArguments<Time, Args...>;
+	using _Values = typename _Base::_Values;
+
+public:
+	Debounce(Event<void(Args...)> & aSource, TimerManager<Time> & aManager, const Time & aInterval)
+	    : _Base(aManager, aInterval)
+	{
+		this->Connect(aSource, [this](Args... aArguments) { OnCall(std::forward<Args>(aArguments)...); },
+		              [this]() { OnTrigger(); });
+	}
+
+private:
+	void OnCall(Args... aArguments)
+	{ // Every call restarts the wait
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(this->StateMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		this->Store(std::forward<Args>(aArguments)...);
+		this->Request(true);
+	}
+
+	void OnTrigger()
+	{
+		_Values Values;
+		{
+#ifndef EL_NO_THREADSAFETY_CHECKS
+			std::lock_guard<std::mutex> Lock(this->StateMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+			this->timer->Pause();
+			if (!this->Pending)
+				return;
+			Values        = std::move(this->Latest);
+			this->Pending = false;
+		}
+		this->Emit(Values);
+	}
+};
+
+// Passes on the latest call once every interval, as long as calls keep coming in.
+template <typename... Args, typename Time>
+class Sample<void(Args...), Time> : public detail::LatestArguments<Time, Args...>
+{
+	using _Base   = detail::LatestArguments<Time, Args...>;
+	using _Values = typename _Base::_Values;
+
+public:
+	Sample(Event<void(Args...)> & aSource, TimerManager<Time> & aManager, const Time & aInterval)
+	    : _Base(aManager, aInterval)
+	{
+		this->Connect(aSource, [this](Args... aArguments) { OnCall(std::forward<Args>(aArguments)...); },
+		              [this]() { OnTrigger(); });
+	}
+
+private:
+	void OnCall(Args... aArguments)
+	{
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(this->StateMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		this->Store(std::forward<Args>(aArguments)...);
+		this->Request(false);
+	}
+
+	void OnTrigger()
+	{
+		_Values Values;
+		{
+#ifndef EL_NO_THREADSAFETY_CHECKS
+			std::lock_guard<std::mutex> Lock(this->StateMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+			if (!this->Pending)
+			{ // No calls since the last sample, wait for the next one
+				this->timer->Pause();
+				return;
+			}
+			Values        = std::move(this->Latest);
+			this->Pending = false;
+		}
+		this->Emit(Values);
+	}
+};
+
+} // namespace el
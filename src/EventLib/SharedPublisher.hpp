@@ -0,0 +1,416 @@
+#pragma region Copyright (c) 2017 Hielke Morsink
+/*****************************************************************************
+ * EventLib, a C++ library to provide classes for event-based programming.
+ *
+ * EventLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifdef __linux__
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#ifndef EL_NO_THREADSAFETY_CHECKS
+#include <mutex>
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Connection.hpp"
+#include "PackedArgs.hpp"
+#include "Publisher.hpp"
+
+namespace el
+{
+
+namespace detail
+{
+
+inline long Futex(std::atomic<std::uint32_t> * aWord, int aOperation, std::uint32_t aValue, const timespec * aTimeout)
+{ // Shared (non-private) futex, so that waiters in other processes can be woken up
+	return syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(aWord), aOperation, aValue, aTimeout, nullptr, 0);
+}
+
+} // namespace detail
+
+// Publisher that broadcasts messages to all processes that opened a shared-memory region with the same name.
+// Messages are written in place into a lock-free ring buffer, which is why the key and all arguments need to be
+// trivially copyable. Every instance keeps its own read position and dispatches received messages to the slots
+// that were registered on it, using the same API as Publisher. When a reader falls more than the capacity behind,
+// the oldest messages are overwritten and counted as dropped. A writer packs its message before it claims a slot, so a
+// slot is only busy while the message gets copied in. Readers skip a message that is still missing after 100ms, and a
+// busy slot is only taken over once the process that claimed it is gone, so a process that dies while publishing
+// blocks neither readers nor writers, and a slow writer can not tear a newer message.
+template <typename Key, typename... Args>
+class SharedPublisher
+{
+	static_assert(std::is_trivially_copyable<Key>::value, "SharedPublisher keys must be trivially copyable");
+	static_assert(detail::AllTriviallyCopyable<Args...>::value, "SharedPublisher arguments must be trivially copyable");
+	static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2, "Shared memory requires lock-free atomics");
+
+	using _Message = detail::PackedArgs<Key, Args...>;
+
+	static constexpr std::uint32_t MagicNumber = 0x454C5350; // "ELSP"
+	static constexpr std::uint64_t BusyFlag    = 1;
+
+	struct Header
+	{
+		std::atomic<std::uint32_t> Magic;
+		std::uint32_t              Capacity;
+		std::uint32_t              MessageSize;
+		alignas(64) std::atomic<std::uint64_t> WriteIndex;
+		alignas(64) std::atomic<std::uint32_t> Futex;
+		std::atomic<std::uint32_t>             Waiters;
+	};
+
+	struct alignas(64) Slot
+	{
+		// Holds (index + 1) << 1 of the message it contains, the lowest bit is set while it is being written
+		std::atomic<std::uint64_t> Sequence;
+		// Lower half of the claimed sequence in the upper 32 bits, and the process id of the writer in the lower ones
+		std::atomic<std::uint64_t> Owner;
+		_Message                   Message;
+	};
+
+public:
+	SharedPublisher(const std::string & aName, std::size_t aCapacity = 1024)
+	    : Name(aName)
+	{ // Open or create the shared ring buffer, the capacity is rounded up to a power of two
+		std::size_t Capacity = 1;
+		while (Capacity < aCapacity)
+			Capacity <<= 1;
+		Mask = Capacity - 1;
+		Size = sizeof(Header) + Capacity * sizeof(Slot);
+
+		bool Creator = true;
+		Descriptor   = shm_open(aName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+		if (Descriptor < 0 && errno == EEXIST)
+		{ // Another process created the region already
+			Creator    = false;
+			Descriptor = shm_open(aName.c_str(), O_RDWR, 0600);
+		}
+		if (Descriptor < 0)
+			throw std::system_error(errno, std::generic_category(), "shm_open failed for " + aName);
+
+		if (Creator && ftruncate(Descriptor, static_cast<off_t>(Size)) != 0)
+			Fail("ftruncate", errno);
+
+		if (!Creator && !WaitForSize())
+			Fail("region size mismatch", EINVAL);
+
+		void * Address = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, Descriptor, 0);
+		if (Address == MAP_FAILED)
+			Fail("mmap", errno);
+
+		Shared = static_cast<Header *>(Address);
+		Slots  = reinterpret_cast<Slot *>(static_cast<char *>(Address) + sizeof(Header));
+
+		if (Creator)
+		{ // Freshly truncated memory is zeroed, only the header needs filling in
+			Shared->Capacity    = static_cast<std::uint32_t>(Capacity);
+			Shared->MessageSize = static_cast<std::uint32_t>(sizeof(_Message));
+			Shared->Magic.store(MagicNumber, std::memory_order_release);
+		}
+		else
+		{ // Wait for the creator to finish initialising the header
+			for (int i = 0; Shared->Magic.load(std::memory_order_acquire) != MagicNumber; i++)
+			{
+				if (i == 1000)
+					Fail("region was never initialised", ETIMEDOUT);
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			if (Shared->Capacity != Capacity || Shared->MessageSize != sizeof(_Message))
+				Fail("region layout mismatch", EINVAL);
+		}
+
+		// Only receive messages that are published from now on
+		ReadIndex = Shared->WriteIndex.load(std::memory_order_acquire);
+		Process   = static_cast<std::uint32_t>(getpid());
+	}
+
+	SharedPublisher(const SharedPublisher &) = delete;
+	SharedPublisher & operator=(const SharedPublisher &) = delete;
+
+	~SharedPublisher()
+	{ // Unmaps the region, it stays alive until it gets unlinked
+		if (Shared != nullptr)
+			munmap(Shared, Size);
+		if (Descriptor >= 0)
+			close(Descriptor);
+	}
+
+	static void Unlink(const std::string & aName)
+	{ // Removes the shared region's name, processes that still have it mapped can keep using it
+		shm_unlink(aName.c_str());
+	}
+
+	template <typename Callable>
+	Connection Register(const Key & aKey, const Callable & aSlot, Location aLocation = Back)
+	{ // Connect a slot that will be called when this instance dispatches a message with the given key
+		return Local.Register(aKey, aSlot, aLocation);
+	}
+
+	void Publish(const Key & aKey, Args... aArguments)
+	{ // Writes the message into the ring buffer and wakes up waiting processes
+		_Message Message;
+		detail::PackArgs(Message, aKey, std::forward<Args>(aArguments)...);
+
+		const std::uint64_t Index    = Shared->WriteIndex.fetch_add(1, std::memory_order_relaxed);
+		const std::uint64_t Sequence = (Index + 1) << 1;
+		Slot &              Target   = Slots[Index & Mask];
+		if (!Claim(Target, Sequence))
+		{
+			WriteDropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		std::atomic_thread_fence(std::memory_order_release);
+		std::memcpy(&Target.Message, &Message, sizeof(_Message));
+
+		std::uint64_t Claimed = Sequence | BusyFlag;
+		if (!Target.Sequence.compare_exchange_strong(Claimed, Sequence, std::memory_order_release,
+		                                             std::memory_order_relaxed))
+		{ // Another writer took the slot over, see Claim
+			WriteDropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		Shared->Futex.fetch_add(1, std::memory_order_seq_cst);
+		if (Shared->Waiters.load(std::memory_order_seq_cst) != 0)
+			detail::Futex(&Shared->Futex, FUTEX_WAKE, INT_MAX, nullptr);
+	}
+
+	void operator()(const Key & aKey, Args... aArguments)
+	{
+		Publish(aKey, std::forward<Args>(aArguments)...);
+	}
+
+	std::size_t Dispatch()
+	{ // Calls the registered slots for all messages received since the last call, returns the amount of messages
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(ReadMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+		std::size_t Count = 0;
+		_Message    Message;
+		while (Read(Message))
+		{
+			Deliver(Message, std::index_sequence_for<Args...>());
+			Count++;
+		}
+		return Count;
+	}
+
+	template <typename Rep, typename Period>
+	std::size_t WaitAndDispatch(const std::chrono::duration<Rep, Period> & aTimeout)
+	{ // Blocks until a message arrives or the timeout expires, then dispatches everything that was received
+		const std::uint32_t Version = Shared->Futex.load(std::memory_order_acquire);
+		if (const std::size_t Count = Dispatch())
+			return Count;
+
+		// Nothing could be read, also when the next message is still being written, so sleep in the kernel until a
+		// writer bumps the futex word
+		const auto Nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(aTimeout).count();
+		timespec   Timeout;
+		Timeout.tv_sec  = static_cast<time_t>(Nanoseconds / 1000000000);
+		Timeout.tv_nsec = static_cast<long>(Nanoseconds % 1000000000);
+
+		Shared->Waiters.fetch_add(1, std::memory_order_seq_cst);
+		detail::Futex(&Shared->Futex, FUTEX_WAIT, Version, &Timeout);
+		Shared->Waiters.fetch_sub(1, std::memory_order_seq_cst);
+		return Dispatch();
+	}
+
+	std::uint64_t GetDroppedCount() const
+	{ // Returns the amount of messages that were overwritten before this instance could read them, or never finished
+		return Dropped;
+	}
+
+	std::uint64_t GetWriteDroppedCount() const
+	{ // Returns the amount of messages published by this instance that never made it into the ring buffer
+		return WriteDropped.load(std::memory_order_relaxed);
+	}
+
+private:
+	static std::chrono::milliseconds StallTimeout()
+	{ // How long a message can take to be written before the writer is assumed to have died
+		return std::chrono::milliseconds(100);
+	}
+
+	static std::uint64_t OwnerTag(std::uint64_t aSequence, std::uint32_t aProcess)
+	{
+		return (aSequence >> 1) << 32 | aProcess;
+	}
+
+	bool Claim(Slot & aTarget, std::uint64_t aSequence)
+	{ // Marks the slot as being written, unless it holds a newer message or a writer that is still alive holds it
+		std::uint64_t                         Current = aTarget.Sequence.load(std::memory_order_relaxed);
+		std::chrono::steady_clock::time_point GiveUp;
+		for (bool Waiting = false;;)
+		{
+			if (Current >= aSequence)
+				return false; // A writer that lapped this one already filled it
+
+			if (Current & BusyFlag)
+			{
+				const auto Now = std::chrono::steady_clock::now();
+				if (!Waiting)
+				{
+					Waiting = true;
+					GiveUp  = Now + StallTimeout();
+				}
+				if (Now < GiveUp)
+				{
+					std::this_thread::yield();
+					Current = aTarget.Sequence.load(std::memory_order_relaxed);
+					continue;
+				}
+				if (OwnerAlive(aTarget, Current))
+					return false; // Taking over would let the slow writer copy over this message
+			}
+
+			if (aTarget.Sequence.compare_exchange_weak(Current, aSequence | BusyFlag, std::memory_order_relaxed))
+			{
+				aTarget.Owner.store(OwnerTag(aSequence, Process), std::memory_order_relaxed);
+				return true;
+			}
+		}
+	}
+
+	static bool OwnerAlive(const Slot & aTarget, std::uint64_t aClaimed)
+	{ // A writer that claimed the slot without recording itself yet has died right after claiming it
+		const std::uint64_t Owner = aTarget.Owner.load(std::memory_order_relaxed);
+		if (Owner >> 32 != ((aClaimed >> 1) & 0xFFFFFFFF))
+			return false;
+		const pid_t Pid = static_cast<pid_t>(Owner & 0xFFFFFFFF);
+		return kill(Pid, 0) == 0 || errno == EPERM;
+	}
+
+	bool Read(_Message & aMessage)
+	{ // Copies the next message, skipping over messages that were overwritten
+		for (;;)
+		{
+			const Slot &        Source   = Slots[ReadIndex & Mask];
+			const std::uint64_t Expected = (ReadIndex + 1) << 1;
+			const std::uint64_t Before   = Source.Sequence.load(std::memory_order_acquire);
+
+			if ((Before & ~BusyFlag) < Expected || Before == (Expected | BusyFlag))
+			{ // Not yet (completely) written, skip it when its writer seems to have died
+				if (Shared->WriteIndex.load(std::memory_order_acquire) <= ReadIndex)
+					return false;
+
+				const auto Now = std::chrono::steady_clock::now();
+				if (StalledIndex != ReadIndex)
+				{
+					StalledIndex = ReadIndex;
+					StalledSince = Now;
+					return false;
+				}
+				if (Now - StalledSince < StallTimeout())
+					return false;
+
+				Dropped++;
+				ReadIndex++;
+				continue;
+			}
+
+			if (Before == Expected)
+			{ // Copy, then verify no writer started overwriting it in the meantime
+				std::memcpy(&aMessage, &Source.Message, sizeof(_Message));
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (Source.Sequence.load(std::memory_order_relaxed) == Before)
+				{
+					ReadIndex++;
+					return true;
+				}
+			}
+
+			// This reader was lapped, continue at the oldest message that can still be read
+			const std::uint64_t WriteIndex = Shared->WriteIndex.load(std::memory_order_acquire);
+			const std::uint64_t Oldest     = WriteIndex > Mask ? WriteIndex - Mask - 1 : 0;
+			const std::uint64_t Next       = Oldest > ReadIndex ? Oldest : ReadIndex + 1;
+			Dropped += Next - ReadIndex;
+			ReadIndex = Next;
+		}
+	}
+
+	template <std::size_t... Indices>
+	void Deliver(_Message & aMessage, std::index_sequence<Indices...>)
+	{
+		Local.Publish(aMessage.Head, detail::PackedGet<Indices>::Get(aMessage.Tail)...);
+	}
+
+	bool WaitForSize() const
+	{ // The creator may not have resized the region yet
+		for (int i = 0; i < 1000; i++)
+		{
+			struct stat Status;
+			if (fstat(Descriptor, &Status) != 0)
+				return false;
+			if (Status.st_size != 0)
+				return static_cast<std::size_t>(Status.st_size) == Size;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return false;
+	}
+
+	[[noreturn]] void Fail(const char * aWhat, int aError)
+	{ // Releases what was acquired so far, as the destructor will not run
+		if (Shared != nullptr)
+			munmap(Shared, Size);
+		if (Descriptor >= 0)
+			close(Descriptor);
+		throw std::system_error(aError, std::generic_category(), std::string("SharedPublisher ") + aWhat + " for " + Name);
+	}
+
+private:
+	std::string   Name;
+	int           Descriptor = -1;
+	std::size_t   Size       = 0;
+	std::size_t   Mask       = 0;
+	Header *      Shared     = nullptr;
+	Slot *        Slots      = nullptr;
+	std::uint64_t ReadIndex  = 0;
+	std::uint64_t Dropped    = 0;
+	std::uint32_t Process    = 0;
+
+	// The message this instance is waiting for, and since when
+	std::uint64_t                         StalledIndex = UINT64_MAX;
+	std::chrono::steady_clock::time_point StalledSince;
+
+	std::atomic<std::uint64_t> WriteDropped{ 0 };
+
+	Publisher<Key, Args...> Local;
+#ifndef EL_NO_THREADSAFETY_CHECKS
+	std::mutex ReadMutex;
+#endif // EL_NO_THREADSAFETY_CHECKS
+};
+
+} // namespace el
+
+#endif // __linux__
@@ -14,16 +14,18 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <functional>
 #include <list>
 #include <memory>
-#include <thread>
 
 #ifndef EL_NO_THREADSAFETY_CHECKS
 #include <mutex>
 #endif // EL_NO_THREADSAFETY_CHECKS
 
 #include "Event.hpp"
+#include "TimerService.hpp"
+#include "Tracing.hpp"
 
 namespace el
 {
@@ -31,24 +33,27 @@ namespace el
 template <typename Time>
 class TimerManager;
 
-template <typename Time>
-class Timer : public std::enable_shared_from_this<Timer<Time>>
+// A timer is owned and driven by a manager, which defaults to TimerManager. Managers that do not tick every timer
+// (such as TimerWheel) keep track of the time left themselves, and get notified when a timer gets changed.
+template <typename Time, typename ManagerType = TimerManager<Time>>
+class Timer : public std::enable_shared_from_this<Timer<Time, ManagerType>>
 {
-	using _TimeManager = TimerManager<Time>;
+	friend ManagerType;
 
 public:
 	Timer() = default;
-	Timer(const Time & aInterval, bool aLooping, _TimeManager * aManager)
+	Timer(const Time & aInterval, bool aLooping, ManagerType * aManager, const Time & aSlack = Time(0))
 	    : Interval(aInterval)
 	    , Watch(aInterval)
+	    , Slack(aSlack)
 	    , Looping(aLooping)
 	    , Manager(aManager)
 	{
 	}
 
-	const Time & GetTimeLeft() const
+	Time GetTimeLeft() const
 	{
-		return Watch;
+		return Manager != nullptr ? Manager->GetTimeLeft(*this) : Watch;
 	}
 
 	const Time & GetInterval() const
@@ -56,14 +61,21 @@ public:
 		return Interval;
 	}
 
+	const Time & GetSlack() const
+	{ // Returns how late the timer is allowed to fire, so it can be batched with other timers
+		return Slack;
+	}
+
 	void SetTimeLeft(const Time & aTimeLeft)
 	{
 		Watch = aTimeLeft;
+		Reschedule();
 	}
 
 	void Reset()
 	{ // Restarts the countdown from the start
 		Watch = Interval;
+		Reschedule();
 	}
 
 	bool HasFinished() const
@@ -78,12 +90,7 @@ public:
 			Watch -= aDeltaTime;
 			if (Watch <= Time(0))
 			{ // Timer has reached 0
-				OnTrigger();
-
-				if (Looping)
-				{ // The timer should start again
-					Reset();
-				}
+				Trigger();
 			}
 		}
 	}
@@ -92,7 +99,9 @@ public:
 	{ // Set paused to true
 		if (!Paused)
 		{
+			Watch  = GetTimeLeft();
 			Paused = true;
+			Reschedule();
 			OnPause();
 		}
 	}
@@ -102,21 +111,42 @@ public:
 		if (Paused)
 		{
 			Paused = false;
+			Reschedule();
 			OnResume();
 		}
 	}
 
 	void Delete()
 	{ // Removes the timer from the timer manager
-		Manager->Remove(shared_from_this());
+		Manager->Remove(this->shared_from_this());
 	}
 
 private:
-	Time           Interval;
-	Time           Watch;
-	bool           Paused = false;
-	bool           Looping;
-	_TimeManager * Manager;
+	void Trigger()
+	{ // Called when the countdown has reached 0
+		OnTrigger();
+
+		if (Looping)
+		{ // The timer should start again
+			Reset();
+		}
+	}
+
+	void Reschedule()
+	{ // Lets the manager know the time left or paused state has changed
+		if (Manager != nullptr)
+			Manager->Reschedule(*this);
+	}
+
+private:
+	Time          Interval;
+	Time          Watch;
+	Time          Slack  = Time(0);
+	bool          Paused = false;
+	bool          Looping;
+	ManagerType * Manager = nullptr;
+
+	typename ManagerType::TimerData Data;
 
 public: // Events
 	Event<void()> OnTrigger;
@@ -130,23 +160,33 @@ class TimerManager
 	using _Timer    = Timer<Time>;
 	using _TimerPtr = std::shared_ptr<_Timer>;
 
+	friend _Timer;
+
+	struct TimerData
+	{ // Every timer gets ticked, only remember whether it fired, as due timers can wait for others within their slack
+		bool Triggered = false;
+	};
+
 public:
+	struct CoalescingStats
+	{
+		std::size_t Triggers  = 0; // Amount of times a timer fired
+		std::size_t Batches   = 0; // Amount of updates in which timers fired
+		std::size_t Coalesced = 0; // Triggers that were within their slack, and fired along with another timer
+	};
+
 	TimerManager()                     = default;
 	TimerManager(const TimerManager &) = delete;
 
 	template <typename T, typename Callable>
-	static void CreateThreaded(const T aSleepTime, Callable aFunc)
-	{ // Create a detached thread to execute the logic after a timeout
-		std::thread thread([=]() {
-			std::this_thread::sleep_for(Time(aSleepTime));
-			aFunc();
-		});
-		thread.detach();
+	static TimerService::Handle CreateThreaded(const T aSleepTime, Callable aFunc)
+	{ // Execute the logic on the shared timer service after a timeout, cancel the handle to cancel it
+		return TimerService::Shared().Schedule(Time(aSleepTime), aFunc);
 	}
 
-	std::shared_ptr<_Timer> & Create(const Time aSleepTime, bool aLooping = false)
-	{ // Create a timer and returns a shared pointer to it
-		_TimerPtr ptr = std::make_shared<_Timer>(_Timer(aSleepTime, aLooping, this));
+	std::shared_ptr<_Timer> & Create(const Time aSleepTime, bool aLooping = false, const Time aSlack = Time(0))
+	{ // Create a timer and returns a shared pointer to it, it is allowed to fire up to aSlack late
+		_TimerPtr ptr = std::make_shared<_Timer>(_Timer(aSleepTime, aLooping, this, aSlack));
 #ifndef EL_NO_THREADSAFETY_CHECKS
 		std::lock_guard<std::mutex> lock(TimersMutex);
 #endif // EL_NO_THREADSAFETY_CHECKS
@@ -161,13 +201,23 @@ public:
 	}
 
 	void UpdateTimers(const Time & aDeltaTime)
-	{ // Removes finished timers, and ticks running timers
+	{ // Removes finished timers and counts down running timers. Without slack every timer fires as soon as it is due, in
+	  // turn, like Tick does. Once a timer has slack, all timers are counted down first and the due ones fire together
+	  // when one runs out of slack.
+#ifndef EL_DISABLE_TRACING
+		const TraceSpan TickSpan("Timer", "TimerManager::UpdateTimers");
+#endif // EL_DISABLE_TRACING
+
+		OnUpdate();
+
 #ifndef EL_NO_THREADSAFETY_CHECKS
 		TimersMutex.lock();
 #endif // EL_NO_THREADSAFETY_CHECKS
 
-		Timers.remove_if([](const _TimerPtr & aTimer) -> bool {
-			return aTimer->HasFinished();
+		bool Coalescing = false;
+		Timers.remove_if([&Coalescing](const _TimerPtr & aTimer) -> bool {
+			Coalescing = Coalescing || aTimer->Slack > Time(0);
+			return aTimer->HasFinished() && aTimer->Data.Triggered;
 		});
 
 		// Create a copy, in case the list gets changed
@@ -177,16 +227,109 @@ public:
 		TimersMutex.unlock();
 #endif // EL_NO_THREADSAFETY_CHECKS
 
-		std::for_each(TimersCopy.begin(), TimersCopy.end(), [&aDeltaTime](_TimerPtr & aTimer) {
-			aTimer->Tick(aDeltaTime);
-		});
+		if (!Coalescing)
+		{ // Nothing can wait for another timer, so slots see the timers after them before they are counted down
+			CoalescingStats Batch;
+			for (_TimerPtr & ptr : TimersCopy)
+			{
+				if (!ptr->Paused)
+				{
+					ptr->Watch -= aDeltaTime;
+					if (ptr->Watch <= Time(0))
+					{ // Timer has reached 0
+						Batch.Triggers++;
+						ptr->Data.Triggered = true;
+						ptr->Trigger();
+					}
+				}
+			}
+			Batch.Batches = Batch.Triggers > 0 ? 1 : 0;
+			AddCoalescingStats(Batch);
+			return;
+		}
+
+		bool BatchDue = false;
+		for (_TimerPtr & ptr : TimersCopy)
+		{
+			if (!ptr->Paused)
+			{
+				ptr->Watch -= aDeltaTime;
+				BatchDue = BatchDue || ptr->Watch <= -ptr->Slack;
+			}
+		}
+
+		if (!BatchDue)
+		{ // Every due timer can still wait for another one
+			return;
+		}
+
+		CoalescingStats Batch;
+		Batch.Batches = 1;
+		for (_TimerPtr & ptr : TimersCopy)
+		{
+			if (!ptr->Paused && ptr->Watch <= Time(0))
+			{ // Timer is due, fire it along with the timer that ran out of slack
+				Batch.Triggers++;
+				if (ptr->Watch > -ptr->Slack)
+					Batch.Coalesced++;
+				ptr->Data.Triggered = true;
+				ptr->Trigger();
+			}
+		}
+
+		AddCoalescingStats(Batch);
+	}
+
+	CoalescingStats GetCoalescingStats() const
+	{ // Returns how many timers fired, and in how many batches
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(TimersMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		return Stats;
+	}
+
+	void ResetCoalescingStats()
+	{
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(TimersMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		Stats = CoalescingStats();
+	}
+
+private:
+	void AddCoalescingStats(const CoalescingStats & aBatch)
+	{
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(TimersMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		Stats.Triggers += aBatch.Triggers;
+		Stats.Batches += aBatch.Batches;
+		Stats.Coalesced += aBatch.Coalesced;
+	}
+
+	Time GetTimeLeft(const _Timer & aTimer) const
+	{ // Watch is counted down on every update
+		return aTimer.Watch;
+	}
+
+	void Reschedule(_Timer & aTimer)
+	{ // Changes are picked up by the next update, but a timer that was given new time has not fired for it yet. Pausing
+	  // and resuming do not change the time left, so a finished timer stays finished.
+		if (aTimer.Watch > Time(0))
+			aTimer.Data.Triggered = false;
 	}
 
 private:
 	std::list<_TimerPtr> Timers;
+	CoalescingStats      Stats;
 #ifndef EL_NO_THREADSAFETY_CHECKS
-	std::mutex TimersMutex;
+	mutable std::mutex TimersMutex;
 #endif // EL_NO_THREADSAFETY_CHECKS
+
+public: // Events
+	// Called at the start of every update, before any timer is counted down. Timers are not thread safe, so this is
+	// where code that runs on other threads can have the updating thread change them.
+	Event<void()> OnUpdate;
 };
 
 } // namespace el
@@ -0,0 +1,468 @@
+#pragma region Copyright (c) 2017 Hielke Morsink
+/*****************************************************************************
+ * EventLib, a C++ library to provide classes for event-based programming.
+ *
+ * EventLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#ifndef EL_NO_THREADSAFETY_CHECKS
+#include <mutex>
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+#if !defined(EL_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define EL_TIMERPOOL_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace el
+{
+
+namespace detail
+{
+
+template <typename Time>
+struct TimeRep
+{ // Arithmetic types are stored as they are
+	using Type = Time;
+
+	static Type Get(const Time & aTime)
+	{
+		return aTime;
+	}
+
+	static Time Make(const Type & aRep)
+	{
+		return aRep;
+	}
+};
+
+template <typename Rep, typename Period>
+struct TimeRep<std::chrono::duration<Rep, Period>>
+{ // Durations are stored as their tick count
+	using Type = Rep;
+
+	static Type Get(const std::chrono::duration<Rep, Period> & aTime)
+	{
+		return aTime.count();
+	}
+
+	static std::chrono::duration<Rep, Period> Make(const Type & aRep)
+	{
+		return std::chrono::duration<Rep, Period>(aRep);
+	}
+};
+
+template <typename T>
+inline std::size_t DecrementAndGatherScalar(T * aRemaining, std::size_t aBegin, std::size_t aEnd, T aDelta,
+                                            std::uint32_t * aFired, std::size_t aFiredCount)
+{ // Branchless, so compilers are able to vectorise it
+	for (std::size_t i = aBegin; i < aEnd; i++)
+	{
+		const T Remaining   = aRemaining[i] - aDelta;
+		aRemaining[i]       = Remaining;
+		aFired[aFiredCount] = static_cast<std::uint32_t>(i);
+		aFiredCount += Remaining <= T(0) ? 1 : 0;
+	}
+	return aFiredCount;
+}
+
+// Subtracts the delta from every value, and writes the indices of values that reached 0 to aFired.
+// aFired needs room for aCount indices, the amount of fired indices is returned.
+template <typename T>
+inline std::size_t DecrementAndGather(T * aRemaining, std::size_t aCount, T aDelta, std::uint32_t * aFired)
+{
+	return DecrementAndGatherScalar(aRemaining, 0, aCount, aDelta, aFired, 0);
+}
+
+#ifdef EL_TIMERPOOL_SSE2
+inline std::size_t GatherMask(int aMask, int aLanes, std::size_t aIndex, std::uint32_t * aFired, std::size_t aCount)
+{ // Appends the index of every set bit, without branching on the bits
+	for (int Lane = 0; Lane < aLanes; Lane++)
+	{
+		aFired[aCount] = static_cast<std::uint32_t>(aIndex + Lane);
+		aCount += (aMask >> Lane) & 1;
+	}
+	return aCount;
+}
+
+template <>
+inline std::size_t DecrementAndGather<float>(float * aRemaining, std::size_t aCount, float aDelta,
+                                             std::uint32_t * aFired)
+{
+	const __m128 Delta = _mm_set1_ps(aDelta);
+	const __m128 Zero  = _mm_setzero_ps();
+
+	std::size_t Fired = 0;
+	std::size_t i     = 0;
+	for (; i + 4 <= aCount; i += 4)
+	{
+		const __m128 Remaining = _mm_sub_ps(_mm_loadu_ps(aRemaining + i), Delta);
+		_mm_storeu_ps(aRemaining + i, Remaining);
+		Fired = GatherMask(_mm_movemask_ps(_mm_cmple_ps(Remaining, Zero)), 4, i, aFired, Fired);
+	}
+	return DecrementAndGatherScalar(aRemaining, i, aCount, aDelta, aFired, Fired);
+}
+
+template <>
+inline std::size_t DecrementAndGather<double>(double * aRemaining, std::size_t aCount, double aDelta,
+                                              std::uint32_t * aFired)
+{
+	const __m128d Delta = _mm_set1_pd(aDelta);
+	const __m128d Zero  = _mm_setzero_pd();
+
+	std::size_t Fired = 0;
+	std::size_t i     = 0;
+	for (; i + 2 <= aCount; i += 2)
+	{
+		const __m128d Remaining = _mm_sub_pd(_mm_loadu_pd(aRemaining + i), Delta);
+		_mm_storeu_pd(aRemaining + i, Remaining);
+		Fired = GatherMask(_mm_movemask_pd(_mm_cmple_pd(Remaining, Zero)), 2, i, aFired, Fired);
+	}
+	return DecrementAndGatherScalar(aRemaining, i, aCount, aDelta, aFired, Fired);
+}
+
+template <>
+inline std::size_t DecrementAndGather<std::int32_t>(std::int32_t * aRemaining, std::size_t aCount,
+                                                    std::int32_t aDelta, std::uint32_t * aFired)
+{
+	const __m128i Delta = _mm_set1_epi32(aDelta);
+	const __m128i One   = _mm_set1_epi32(1);
+
+	std::size_t Fired = 0;
+	std::size_t i     = 0;
+	for (; i + 4 <= aCount; i += 4)
+	{
+		__m128i * const Address   = reinterpret_cast<__m128i *>(aRemaining + i);
+		const __m128i   Remaining = _mm_sub_epi32(_mm_loadu_si128(Address), Delta);
+		_mm_storeu_si128(Address, Remaining);
+		// Remaining <= 0 is the same as Remaining < 1
+		Fired = GatherMask(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(Remaining, One))), 4, i, aFired, Fired);
+	}
+	return DecrementAndGatherScalar(aRemaining, i, aCount, aDelta, aFired, Fired);
+}
+
+template <>
+inline std::size_t DecrementAndGather<std::int64_t>(std::int64_t * aRemaining, std::size_t aCount,
+                                                    std::int64_t aDelta, std::uint32_t * aFired)
+{ // SSE2 has no 64-bit compare, but Remaining - 1 has its sign bit set exactly when Remaining <= 0
+	const __m128i Delta = _mm_set1_epi64x(aDelta);
+	const __m128i One   = _mm_set1_epi64x(1);
+
+	std::size_t Fired = 0;
+	std::size_t i     = 0;
+	for (; i + 2 <= aCount; i += 2)
+	{
+		__m128i * const Address   = reinterpret_cast<__m128i *>(aRemaining + i);
+		const __m128i   Remaining = _mm_sub_epi64(_mm_loadu_si128(Address), Delta);
+		_mm_storeu_si128(Address, Remaining);
+		Fired = GatherMask(_mm_movemask_pd(_mm_castsi128_pd(_mm_sub_epi64(Remaining, One))), 2, i, aFired, Fired);
+	}
+	return DecrementAndGatherScalar(aRemaining, i, aCount, aDelta, aFired, Fired);
+}
+#endif // EL_TIMERPOOL_SSE2
+
+} // namespace detail
+
+// Pool of simple countdown timers for when there are too many to give each its own Timer object. The hot state is
+// stored as contiguous arrays, with running timers packed in front of paused ones, so an update is a single SIMD pass
+// that decrements the time left and gathers the indices of the timers that fired. Callbacks are stored separately and
+// only get touched for timers that fired. Timers are referred to by a handle, which stays valid until it is removed.
+// A handle holds the generation of its slot, so it does not refer to a later timer that reuses the slot.
+// Looping timers restart from their interval after firing, like Timer does.
+template <typename Time>
+class TimerPool
+{
+	using _Rep = typename detail::TimeRep<Time>::Type;
+
+public:
+	using Handle = std::uint64_t; // Generation in the upper 32 bits, slot in the lower 32 bits
+
+	TimerPool()                  = default;
+	TimerPool(const TimerPool &) = delete;
+
+	Handle Create(const Time aInterval, bool aLooping = false)
+	{ // Create a timer without a callback, it can still be found through GetFired()
+		return Create(aInterval, aLooping, std::function<void()>());
+	}
+
+	template <typename Callable>
+	Handle Create(const Time aInterval, bool aLooping, const Callable & aCallback)
+	{ // Create a running timer and returns its handle
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(PoolMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+		std::uint32_t Slot;
+		if (FreeSlots.empty())
+		{
+			Slot = static_cast<std::uint32_t>(Positions.size());
+			Positions.push_back(0);
+			Generations.push_back(0);
+			Callbacks.emplace_back();
+		}
+		else
+		{
+			Slot = FreeSlots.back();
+			FreeSlots.pop_back();
+		}
+		Callbacks[Slot] = aCallback;
+
+		// Append, then move the first paused timer out of the way to keep running timers in front
+		const std::size_t Index = Slots.size();
+		Remaining.push_back(detail::TimeRep<Time>::Get(aInterval));
+		Intervals.push_back(detail::TimeRep<Time>::Get(aInterval));
+		Looping.push_back(aLooping ? 1 : 0);
+		Slots.push_back(Slot);
+		Positions[Slot] = static_cast<std::uint32_t>(Index);
+		Swap(Index, RunningCount++);
+		return MakeHandle(Slot);
+	}
+
+	void Remove(const Handle aHandle)
+	{ // Removes a timer, its handle may be reused afterwards
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(PoolMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		Erase(aHandle);
+	}
+
+	bool Contains(const Handle aHandle) const
+	{ // Returns whether or not the handle refers to a timer in the pool
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(PoolMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		return IsValid(aHandle);
+	}
+
+	void Pause(const Handle aHandle)
+	{ // Moves the timer behind the running timers
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(PoolMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		if (IsValid(aHandle) && PositionOf(aHandle) < RunningCount)
+			Swap(PositionOf(aHandle), --RunningCount);
+	}
+
+	void Resume(const Handle aHandle)
+	{ // Moves the timer back with the running timers
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(PoolMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		if (IsValid(aHandle) && PositionOf(aHandle) >= RunningCount)
+			Swap(PositionOf(aHandle), RunningCount++);
+	}
+
+	bool IsPaused(const Handle aHandle) const
+	{
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(PoolMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		return IsValid(aHandle) && PositionOf(aHandle) >= RunningCount;
+	}
+
+	Time GetTimeLeft(const Handle aHandle) const
+	{ // Returns zero for handles that are not in the pool
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(PoolMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		return detail::TimeRep<Time>::Make(IsValid(aHandle) ? Remaining[PositionOf(aHandle)] : _Rep(0));
+	}
+
+	void SetTimeLeft(const Handle aHandle, const Time & aTimeLeft)
+	{
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(PoolMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		if (IsValid(aHandle))
+			Remaining[PositionOf(aHandle)] = detail::TimeRep<Time>::Get(aTimeLeft);
+	}
+
+	void Reset(const Handle aHandle)
+	{ // Restarts the countdown from the start
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(PoolMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		if (IsValid(aHandle))
+			Remaining[PositionOf(aHandle)] = Intervals[PositionOf(aHandle)];
+	}
+
+	std::size_t Count() const
+	{ // Returns the number of timers in the pool, including paused ones
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> Lock(PoolMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		return Slots.size();
+	}
+
+	void UpdateTimers(const Time & aDeltaTime)
+	{ // Counts down all running timers, then calls the callbacks of the timers that fired
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::unique_lock<std::mutex> Lock(PoolMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+		if (FiredIndices.size() < RunningCount)
+			FiredIndices.resize(RunningCount);
+
+		const std::size_t FiredCount = detail::DecrementAndGather<_Rep>(
+		    Remaining.data(), RunningCount, detail::TimeRep<Time>::Get(aDeltaTime), FiredIndices.data());
+
+		// Indices change when timers get removed, so refer to the fired timers by their handles from here on
+		Fired.resize(FiredCount);
+		for (std::size_t i = 0; i < FiredCount; i++)
+		{
+			Fired[i] = MakeHandle(Slots[FiredIndices[i]]);
+		}
+
+		Dispatching = true;
+		for (const Handle handle : Fired)
+		{
+			if (!IsValid(handle) || !Callbacks[SlotOf(handle)])
+				continue; // Removed by an earlier callback, or has no callback
+
+#ifndef EL_NO_THREADSAFETY_CHECKS
+			Lock.unlock();
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+			Callbacks[SlotOf(handle)]();
+
+#ifndef EL_NO_THREADSAFETY_CHECKS
+			Lock.lock();
+#endif // EL_NO_THREADSAFETY_CHECKS
+		}
+		Dispatching = false;
+
+		for (const Handle handle : Fired)
+		{ // Restart or remove the fired timers, unless a callback gave them more time
+			if (!IsValid(handle))
+				continue;
+
+			const std::size_t Index = PositionOf(handle);
+			if (Remaining[Index] <= _Rep(0))
+			{
+				if (Looping[Index])
+					Remaining[Index] = Intervals[Index];
+				else
+					Erase(handle);
+			}
+		}
+
+		for (const std::uint32_t Slot : Released)
+		{ // Callbacks removed while dispatching can be destroyed now
+			Callbacks[Slot] = nullptr;
+			FreeSlots.push_back(Slot);
+		}
+		Released.clear();
+	}
+
+	const std::vector<Handle> & GetFired() const
+	{ // Returns the handles of the timers that fired during the last update
+		return Fired;
+	}
+
+private:
+	static std::uint32_t SlotOf(const Handle aHandle)
+	{
+		return static_cast<std::uint32_t>(aHandle);
+	}
+
+	Handle MakeHandle(const std::uint32_t aSlot) const
+	{
+		return Handle(Generations[aSlot]) << 32 | aSlot;
+	}
+
+	std::size_t PositionOf(const Handle aHandle) const
+	{
+		return Positions[SlotOf(aHandle)];
+	}
+
+	bool IsValid(const Handle aHandle) const
+	{ // Removing a timer bumps the generation of its slot, which invalidates all handles to it
+		const std::uint32_t Slot = SlotOf(aHandle);
+		return Slot < Positions.size() && Generations[Slot] == static_cast<std::uint32_t>(aHandle >> 32) &&
+		       Positions[Slot] < Slots.size() && Slots[Positions[Slot]] == Slot;
+	}
+
+	void Swap(std::size_t aFirst, std::size_t aSecond)
+	{ // Swaps two timers in all arrays, and updates their positions
+		if (aFirst == aSecond)
+			return;
+
+		std::swap(Remaining[aFirst], Remaining[aSecond]);
+		std::swap(Intervals[aFirst], Intervals[aSecond]);
+		std::swap(Looping[aFirst], Looping[aSecond]);
+		std::swap(Slots[aFirst], Slots[aSecond]);
+		Positions[Slots[aFirst]]  = static_cast<std::uint32_t>(aFirst);
+		Positions[Slots[aSecond]] = static_cast<std::uint32_t>(aSecond);
+	}
+
+	void Erase(const Handle aHandle)
+	{ // Moves the timer to the back in two steps, to keep running timers in front, and then pops it
+		if (!IsValid(aHandle))
+			return;
+
+		const std::uint32_t Slot  = SlotOf(aHandle);
+		std::size_t         Index = Positions[Slot];
+		if (Index < RunningCount)
+		{
+			Swap(Index, --RunningCount);
+			Index = RunningCount;
+		}
+		Swap(Index, Slots.size() - 1);
+
+		Remaining.pop_back();
+		Intervals.pop_back();
+		Looping.pop_back();
+		Slots.pop_back();
+		Generations[Slot]++;
+
+		if (Dispatching)
+		{ // The callback may be running right now
+			Released.push_back(Slot);
+		}
+		else
+		{
+			Callbacks[Slot] = nullptr;
+			FreeSlots.push_back(Slot);
+		}
+	}
+
+private:
+	// Hot state, indexed by position, with running timers in [0, RunningCount)
+	std::vector<_Rep>         Remaining;
+	std::vector<_Rep>         Intervals;
+	std::vector<std::uint8_t> Looping;
+	std::vector<std::uint32_t> Slots;
+	std::size_t                RunningCount = 0;
+
+	// Cold state, indexed by slot
+	std::vector<std::uint32_t>         Positions;
+	std::vector<std::uint32_t>         Generations;
+	std::deque<std::function<void()>> Callbacks; // Does not move callbacks that are running when growing
+	std::vector<std::uint32_t>         FreeSlots;
+	std::vector<std::uint32_t>         Released;
+
+	std::vector<std::uint32_t> FiredIndices;
+	std::vector<Handle>        Fired;
+	bool                       Dispatching = false;
+#ifndef EL_NO_THREADSAFETY_CHECKS
+	mutable std::mutex PoolMutex;
+#endif // EL_NO_THREADSAFETY_CHECKS
+};
+
+} // namespace el
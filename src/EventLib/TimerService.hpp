@@ -0,0 +1,267 @@
+#pragma region Copyright (c) 2017 Hielke Morsink
+/*****************************************************************************
+ * EventLib, a C++ library to provide classes for event-based programming.
+ *
+ * EventLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace el
+{
+
+// Runs delayed callbacks from a single scheduler thread that waits on a deadline-ordered queue, and hands expired
+// callbacks to a fixed number of worker threads. Scheduling returns a handle, which cancels the callback when it is
+// cancelled before a worker starts running it. Cancelled callbacks are removed from the queue once they make up
+// about half of it, so scheduling and cancelling a lot does not grow the queue.
+class TimerService
+{
+	using Clock     = std::chrono::steady_clock;
+	using TimePoint = Clock::time_point;
+	using _Slot     = std::function<void()>;
+	using _Flag     = std::shared_ptr<std::atomic<bool>>;
+
+	struct Entry
+	{
+		TimePoint              Deadline;
+		std::uint64_t          Order; // Keeps callbacks with equal deadlines in the order they were scheduled
+		_Flag                  Cancelled;
+		std::shared_ptr<_Slot> slot;
+
+		bool Live() const
+		{
+			return !Cancelled->load(std::memory_order_acquire);
+		}
+
+		bool operator>(const Entry & aOther) const
+		{
+			return Deadline != aOther.Deadline ? Deadline > aOther.Deadline : Order > aOther.Order;
+		}
+	};
+
+public:
+	class Handle
+	{ // Cancels a scheduled callback, can be used from any thread
+	public:
+		Handle() = default;
+
+		explicit Handle(const _Flag & aCancelled)
+		    : CancelledPtr(aCancelled)
+		{
+		}
+
+		void Cancel()
+		{ // A callback that a worker already started running is not stopped
+			if (CancelledPtr)
+				CancelledPtr->store(true, std::memory_order_release);
+		}
+
+		bool Cancelled() const
+		{
+			return !CancelledPtr || CancelledPtr->load(std::memory_order_acquire);
+		}
+
+	private:
+		_Flag CancelledPtr;
+	};
+
+	explicit TimerService(std::size_t aWorkerCount = 1)
+	{ // Starts the scheduler thread and the worker threads
+		Scheduler = std::thread([this]() { RunScheduler(); });
+		for (std::size_t i = 0; i < std::max<std::size_t>(aWorkerCount, 1); i++)
+		{
+			Workers.emplace_back([this]() { RunWorker(); });
+		}
+	}
+
+	TimerService(const TimerService &) = delete;
+
+	~TimerService()
+	{ // Drops pending callbacks, lets the workers finish what is ready to run, and joins all threads
+		{
+			std::lock_guard<std::mutex> Lock(ServiceMutex);
+			Stopping = true;
+		}
+		DeadlineChanged.notify_all();
+		Scheduler.join();
+
+		{
+			std::lock_guard<std::mutex> Lock(WorkMutex);
+			WorkersStopping = true;
+		}
+		WorkAvailable.notify_all();
+		for (std::thread & Worker : Workers)
+		{
+			Worker.join();
+		}
+	}
+
+	static TimerService & Shared()
+	{ // Service used by TimerManager::CreateThreaded. It has a worker per hardware thread, and at least two, so that a
+	  // callback that blocks does not hold up all others
+		static TimerService Instance(std::max(2u, std::thread::hardware_concurrency()));
+		return Instance;
+	}
+
+	template <typename Rep, typename Period, typename Callable>
+	Handle Schedule(const std::chrono::duration<Rep, Period> & aDelay, const Callable & aFunc)
+	{ // Calls the function on a worker thread once the delay has passed
+		return ScheduleAt(Clock::now() + std::chrono::duration_cast<Clock::duration>(aDelay), aFunc);
+	}
+
+	template <typename Callable>
+	Handle ScheduleAt(const TimePoint & aDeadline, const Callable & aFunc)
+	{ // Calls the function on a worker thread once the deadline has passed
+		std::shared_ptr<_Slot> Slot      = std::make_shared<_Slot>(aFunc);
+		_Flag                  Cancelled = std::make_shared<std::atomic<bool>>(false);
+
+		bool Earliest;
+		{
+			std::lock_guard<std::mutex> Lock(ServiceMutex);
+			Earliest = Pending.empty() || aDeadline < Pending.front().Deadline;
+			Pending.push_back(Entry{ aDeadline, NextOrder++, Cancelled, Slot });
+			std::push_heap(Pending.begin(), Pending.end(), std::greater<Entry>());
+			if (Pending.size() >= CompactAt)
+				Compact();
+		}
+
+		if (Earliest)
+		{ // Only wake the scheduler when it has to wait for a shorter time
+			DeadlineChanged.notify_one();
+		}
+		return Handle(Cancelled);
+	}
+
+	std::size_t PendingCount() const
+	{ // Returns the amount of callbacks that are waiting for their deadline, including cancelled ones that are not
+	  // removed yet
+		std::lock_guard<std::mutex> Lock(ServiceMutex);
+		return Pending.size();
+	}
+
+private:
+	void Compact()
+	{ // Removes cancelled callbacks, the queue has to double in size before this is done again
+		Pending.erase(std::remove_if(Pending.begin(), Pending.end(),
+		                             [](const Entry & aEntry) { return !aEntry.Live(); }),
+		              Pending.end());
+		std::make_heap(Pending.begin(), Pending.end(), std::greater<Entry>());
+		CompactAt = std::max(std::size_t(MinimumCompactSize), Pending.size() * 2);
+	}
+
+	void RunScheduler()
+	{ // Sleeps until the earliest deadline, then moves all expired callbacks to the workers
+		std::vector<Entry>           Expired;
+		std::unique_lock<std::mutex> Lock(ServiceMutex);
+		while (!Stopping)
+		{
+			if (Pending.empty())
+			{
+				DeadlineChanged.wait(Lock);
+				continue;
+			}
+
+			const TimePoint Now      = Clock::now();
+			const TimePoint Deadline = Pending.front().Deadline; // Scheduling while waiting can move the queue
+			if (Now < Deadline)
+			{
+				DeadlineChanged.wait_until(Lock, Deadline);
+				continue;
+			}
+
+			while (!Pending.empty() && Pending.front().Deadline <= Now)
+			{
+				std::pop_heap(Pending.begin(), Pending.end(), std::greater<Entry>());
+				if (Pending.back().Live())
+				{ // Cancelled callbacks are dropped here
+					Expired.push_back(std::move(Pending.back()));
+				}
+				Pending.pop_back();
+			}
+
+			// Hand the callbacks over without blocking new ones from being scheduled
+			Lock.unlock();
+			if (!Expired.empty())
+			{
+				{
+					std::lock_guard<std::mutex> WorkLock(WorkMutex);
+					Ready.insert(Ready.end(), Expired.begin(), Expired.end());
+				}
+				if (Expired.size() == 1)
+					WorkAvailable.notify_one();
+				else
+					WorkAvailable.notify_all();
+				Expired.clear();
+			}
+			Lock.lock();
+		}
+	}
+
+	void RunWorker()
+	{ // Takes a share of the ready callbacks at a time, so workers do not contend on every callback
+		std::vector<Entry>           Batch;
+		std::unique_lock<std::mutex> Lock(WorkMutex);
+		for (;;)
+		{
+			WorkAvailable.wait(Lock, [this]() { return WorkersStopping || !Ready.empty(); });
+			if (Ready.empty())
+				return; // Stopping
+
+			const std::size_t Share = (Ready.size() + Workers.size() - 1) / Workers.size(); // Leave some for the others
+			const auto        Last  = Ready.begin() + static_cast<std::ptrdiff_t>(Share);
+			Batch.assign(Ready.begin(), Last);
+			Ready.erase(Ready.begin(), Last);
+
+			Lock.unlock();
+			for (Entry & entry : Batch)
+			{
+				if (entry.Live())
+				{ // Could have been cancelled while it was waiting for a worker
+					(*entry.slot)();
+				}
+			}
+			Batch.clear();
+			Lock.lock();
+		}
+	}
+
+private:
+	static constexpr std::size_t MinimumCompactSize = 64;
+
+	std::vector<Entry> Pending; // Heap with the earliest deadline in front
+	std::size_t        CompactAt = MinimumCompactSize;
+	std::uint64_t      NextOrder = 0;
+	bool               Stopping  = false;
+
+	mutable std::mutex      ServiceMutex;
+	std::condition_variable DeadlineChanged;
+
+	std::deque<Entry>       Ready;
+	bool                    WorkersStopping = false;
+	std::mutex              WorkMutex;
+	std::condition_variable WorkAvailable;
+
+	std::thread              Scheduler;
+	std::vector<std::thread> Workers;
+};
+
+} // namespace el
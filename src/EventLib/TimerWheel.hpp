@@ -0,0 +1,256 @@
+#pragma region Copyright (c) 2017 Hielke Morsink
+/*****************************************************************************
+ * EventLib, a C++ library to provide classes for event-based programming.
+ *
+ * EventLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+
+#ifndef EL_NO_THREADSAFETY_CHECKS
+#include <mutex>
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+#include "Timer.hpp"
+
+namespace el
+{
+
+// Timer manager backed by a hierarchical timing wheel. Time is divided into ticks of a fixed resolution, and timers
+// are hashed into a slot by the tick they are due at. Creating, deleting, pausing and rescheduling a timer are O(1),
+// and an update only touches the slots of the ticks that passed, so timers that are not due cost nothing.
+// Timers fire at the first tick boundary at or after their deadline, and looping timers restart from that tick.
+template <typename Time>
+class TimerWheel
+{
+	using _Timer     = Timer<Time, TimerWheel<Time>>;
+	using _TimerPtr  = std::shared_ptr<_Timer>;
+	using _TimerList = std::list<_TimerPtr>;
+
+	friend _Timer;
+
+	static constexpr unsigned    SlotBits  = 6;
+	static constexpr std::size_t SlotCount = std::size_t(1) << SlotBits;
+	static constexpr std::size_t SlotMask  = SlotCount - 1;
+	static constexpr unsigned    Levels    = 4;
+
+	struct TimerData
+	{ // Where the timer is stored, and the tick it is due at
+		_TimerList *                  List = nullptr;
+		typename _TimerList::iterator Position;
+		std::uint64_t                 Due = 0;
+	};
+
+public:
+	explicit TimerWheel(const Time & aResolution)
+	    : Resolution(aResolution)
+	{
+	}
+
+	TimerWheel(const TimerWheel &) = delete;
+
+	std::shared_ptr<_Timer> Create(const Time aSleepTime, bool aLooping = false)
+	{ // Create a timer and returns a shared pointer to it
+		_TimerPtr ptr = std::make_shared<_Timer>(aSleepTime, aLooping, this);
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(WheelMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		Parked.push_back(ptr);
+		Link(*ptr, Parked, std::prev(Parked.end()));
+		Schedule(*ptr);
+		return ptr;
+	}
+
+	void Remove(const _TimerPtr & ptr)
+	{ // Removes a timer from the wheel
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(WheelMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		Unlink(*ptr);
+	}
+
+	void UpdateTimers(const Time & aDeltaTime)
+	{ // Advances the wheel, firing the timers of every tick that has passed
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::unique_lock<std::mutex> lock(WheelMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+		// While ticks are processed, the current time is exactly at the tick boundary
+		Time Remaining = Accumulated + aDeltaTime;
+		Accumulated    = Time(0);
+
+		while (!(Remaining < Resolution))
+		{
+			Remaining -= Resolution;
+			Advance();
+
+			while (!Firing.empty())
+			{ // Fire outside of the lock, so the slots are free to change the timer
+				_TimerPtr Expired = Firing.front();
+				Expired->Watch    = Time(0);
+
+#ifndef EL_NO_THREADSAFETY_CHECKS
+				lock.unlock();
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+				Expired->Trigger();
+
+#ifndef EL_NO_THREADSAFETY_CHECKS
+				lock.lock();
+#endif // EL_NO_THREADSAFETY_CHECKS
+
+				if (Expired->Data.List == &Firing)
+				{ // Not rescheduled, deleted or paused while firing, so it has finished
+					Unlink(*Expired);
+				}
+			}
+		}
+
+		Accumulated = Remaining;
+	}
+
+	std::size_t Count() const
+	{ // Returns the number of timers in the wheel, including paused ones
+		return Size;
+	}
+
+private:
+	Time GetTimeLeft(const _Timer & aTimer) const
+	{ // Scheduled timers only store the tick they are due at
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(WheelMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		if (aTimer.Data.List == nullptr || aTimer.Data.List == &Parked || aTimer.Data.List == &Firing)
+			return aTimer.Watch;
+		return Resolution * static_cast<long long>(aTimer.Data.Due - Now) - Accumulated;
+	}
+
+	void Reschedule(_Timer & aTimer)
+	{ // Moves the timer to the slot matching its new time left, or parks it when paused
+#ifndef EL_NO_THREADSAFETY_CHECKS
+		std::lock_guard<std::mutex> lock(WheelMutex);
+#endif // EL_NO_THREADSAFETY_CHECKS
+		if (aTimer.Data.List != nullptr)
+		{ // Timers that were removed stay removed
+			Schedule(aTimer);
+		}
+	}
+
+	void Schedule(_Timer & aTimer)
+	{
+		if (aTimer.Paused)
+		{
+			Move(aTimer, Parked);
+			return;
+		}
+
+		// Round up to the tick at which at least the time left will have passed
+		const Time    Pending = aTimer.Watch + Accumulated;
+		std::uint64_t Ticks   = 1;
+		if (Resolution < Pending)
+		{
+			Ticks = static_cast<std::uint64_t>(Pending / Resolution);
+			if (Resolution * static_cast<long long>(Ticks) < Pending)
+				Ticks++;
+		}
+
+		aTimer.Data.Due = Now + Ticks;
+		Place(aTimer);
+	}
+
+	void Place(_Timer & aTimer)
+	{ // Puts the timer in the lowest level that can hold its due tick
+		const std::uint64_t Delta = aTimer.Data.Due - Now;
+		for (unsigned Level = 0; Level < Levels; Level++)
+		{
+			const unsigned Shift = Level * SlotBits;
+			if (Delta < (std::uint64_t(1) << (Shift + SlotBits)) || Level == Levels - 1)
+			{
+				// Timers beyond the range of the top level are clamped to its furthest slot and placed again later
+				const std::uint64_t Limit = (std::uint64_t(1) << (Shift + SlotBits)) - 1;
+				const std::uint64_t Due   = Delta < Limit ? aTimer.Data.Due : Now + Limit;
+				Move(aTimer, Wheels[Level][(Due >> Shift) & SlotMask]);
+				return;
+			}
+		}
+	}
+
+	void Advance()
+	{ // Moves to the next tick, cascading timers down from higher levels when a lower level wraps around
+		Now++;
+
+		for (unsigned Level = 1; Level < Levels; Level++)
+		{
+			const unsigned Shift = Level * SlotBits;
+			if ((Now & ((std::uint64_t(1) << Shift) - 1)) != 0)
+				break;
+
+			_TimerList & Slot = Wheels[Level][(Now >> Shift) & SlotMask];
+			while (!Slot.empty())
+			{
+				Place(*Slot.front());
+			}
+		}
+
+		_TimerList & Slot = Wheels[0][Now & SlotMask];
+		while (!Slot.empty())
+		{
+			_Timer & Expired = *Slot.front();
+			if (Expired.Data.Due <= Now)
+				Move(Expired, Firing);
+			else
+				Place(Expired);
+		}
+	}
+
+	void Link(_Timer & aTimer, _TimerList & aList, typename _TimerList::iterator aPosition)
+	{
+		aTimer.Data.List     = &aList;
+		aTimer.Data.Position = aPosition;
+		Size++;
+	}
+
+	void Move(_Timer & aTimer, _TimerList & aList)
+	{ // Splicing keeps the iterator valid and does not allocate
+		aList.splice(aList.end(), *aTimer.Data.List, aTimer.Data.Position);
+		aTimer.Data.List = &aList;
+	}
+
+	void Unlink(_Timer & aTimer)
+	{
+		if (aTimer.Data.List != nullptr)
+		{
+			_TimerList * List = aTimer.Data.List;
+			aTimer.Data.List  = nullptr;
+			Size--;
+			List->erase(aTimer.Data.Position); // May destroy the timer
+		}
+	}
+
+private:
+	Time          Resolution;
+	Time          Accumulated = Time(0);
+	std::uint64_t Now         = 0;
+	std::size_t   Size        = 0;
+
+	_TimerList Wheels[Levels][SlotCount];
+	_TimerList Parked;
+	_TimerList Firing;
+#ifndef EL_NO_THREADSAFETY_CHECKS
+	mutable std::mutex WheelMutex;
+#endif // EL_NO_THREADSAFETY_CHECKS
+};
+
+} // namespace el
@@ -0,0 +1,335 @@
+#pragma region Copyright (c) 2017 Hielke Morsink
+/*****************************************************************************
+ * EventLib, a C++ library to provide classes for event-based programming.
+ *
+ * EventLib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace el
+{
+
+namespace detail
+{
+
+template <typename GroupType>
+std::int64_t TraceGroup(const GroupType & aGroup, std::true_type)
+{
+	return static_cast<std::int64_t>(aGroup);
+}
+
+template <typename GroupType>
+std::int64_t TraceGroup(const GroupType &, std::false_type)
+{ // Groups that are not numbers are not written to the trace
+	return -1;
+}
+
+template <typename GroupType>
+std::int64_t TraceGroup(const GroupType & aGroup)
+{
+	using Numeric = std::integral_constant<bool, std::is_integral<GroupType>::value || std::is_enum<GroupType>::value>;
+	return TraceGroup(aGroup, Numeric());
+}
+
+} // namespace detail
+
+} // namespace el
+
+// Tracing is compiled in unless EL_DISABLE_TRACING is defined. It starts disabled, and while it is disabled every span
+// costs a single branch on a flag.
+#ifndef EL_DISABLE_TRACING
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace el
+{
+
+namespace detail
+{
+
+inline std::atomic<bool> & TracingFlag()
+{ // Constant initialised, so checking it does not need a guard
+	static std::atomic<bool> Flag(false);
+	return Flag;
+}
+
+} // namespace detail
+
+// Collects spans from all threads, and writes them as a Chrome trace event file. Every thread writes to its own
+// fixed size ring buffer without locking, and flushing empties the buffers. Spans that do not fit because the buffer
+// of a thread is full are dropped and counted.
+class Tracer
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct Span
+	{
+		const char *  Category;
+		const char *  Name;
+		std::uint64_t Begin; // Nanoseconds since the tracer was created
+		std::uint64_t Duration;
+		std::uint64_t Slot; // Zero when the span is not about a slot
+		std::int64_t  Group;
+	};
+
+	struct ThreadBuffer
+	{ // Ring buffer with a single writer (its thread) and a single reader (flushing, under the tracer mutex)
+		std::vector<Span>          Spans;
+		std::uint64_t              Thread;
+		std::atomic<std::uint64_t> Write{ 0 };
+		std::atomic<std::uint64_t> Read{ 0 };
+		std::atomic<std::uint64_t> Dropped{ 0 };
+		std::atomic<bool>          Finished{ false };
+	};
+
+	struct ThreadHandle
+	{ // Keeps the buffer of a thread registered, and marks it as finished when the thread exits
+		std::shared_ptr<ThreadBuffer> Buffer;
+
+		~ThreadHandle()
+		{
+			if (Buffer)
+				Buffer->Finished = true;
+		}
+	};
+
+public:
+	static constexpr std::size_t BufferCapacity = std::size_t(1) << 16; // Spans per thread, a power of two
+
+	Tracer(const Tracer &) = delete;
+
+	static Tracer & Shared()
+	{
+		static Tracer Instance;
+		return Instance;
+	}
+
+	static bool Enabled()
+	{
+		return detail::TracingFlag().load(std::memory_order_relaxed);
+	}
+
+	static void Enable()
+	{
+		Shared(); // Sets the start of the timeline
+		detail::TracingFlag().store(true, std::memory_order_relaxed);
+	}
+
+	static void Disable()
+	{
+		detail::TracingFlag().store(false, std::memory_order_relaxed);
+	}
+
+	const char * Intern(const std::string & aName)
+	{ // Returns a copy of the name that stays valid, so spans can refer to it after its owner is gone
+		std::lock_guard<std::mutex> Lock(TracerMutex);
+		return Names.insert(aName).first->c_str();
+	}
+
+	void Record(const char * aCategory, const char * aName, Clock::time_point aBegin, Clock::time_point aEnd,
+	            std::uint64_t aSlot, std::int64_t aGroup)
+	{
+		ThreadBuffer &      Buffer = GetThreadBuffer();
+		const std::uint64_t Write  = Buffer.Write.load(std::memory_order_relaxed);
+		if (Write - Buffer.Read.load(std::memory_order_acquire) >= BufferCapacity)
+		{
+			Buffer.Dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		Span & span   = Buffer.Spans[Write & (BufferCapacity - 1)];
+		span.Category = aCategory;
+		span.Name     = aName;
+		span.Begin    = Nanoseconds(aBegin - Epoch);
+		span.Duration = Nanoseconds(aEnd - aBegin);
+		span.Slot     = aSlot;
+		span.Group    = aGroup;
+		Buffer.Write.store(Write + 1, std::memory_order_release);
+	}
+
+	void Flush(std::ostream & aStream)
+	{ // Writes the spans recorded so far as a Chrome trace event JSON object, and removes them from the buffers
+		std::lock_guard<std::mutex> Lock(TracerMutex);
+
+		aStream << "{\"traceEvents\":[";
+		bool                                       First = true;
+		std::vector<std::shared_ptr<ThreadBuffer>> Active;
+		for (const std::shared_ptr<ThreadBuffer> & Buffer : Buffers)
+		{
+			// Buffers of threads that have exited are not written to anymore, so they can go once they are read
+			const bool Finished = Buffer->Finished.load(std::memory_order_acquire);
+			if (Finished)
+				FinishedDropped += Buffer->Dropped.load(std::memory_order_relaxed);
+			else
+				Active.push_back(Buffer);
+
+			aStream << (First ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << Buffer->Thread
+			        << ",\"args\":{\"name\":\"Thread " << Buffer->Thread << "\"}}";
+			First = false;
+
+			const std::uint64_t Read  = Buffer->Read.load(std::memory_order_relaxed);
+			const std::uint64_t Write = Buffer->Write.load(std::memory_order_acquire);
+			for (std::uint64_t i = Read; i < Write; i++)
+			{
+				const Span & span = Buffer->Spans[i & (BufferCapacity - 1)];
+				aStream << ",\n{\"name\":";
+				WriteString(aStream, span.Name);
+				aStream << ",\"cat\":";
+				WriteString(aStream, span.Category);
+				aStream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << Buffer->Thread << ",\"ts\":" << span.Begin / 1000 << "."
+				        << Fraction(span.Begin) << ",\"dur\":" << span.Duration / 1000 << "." << Fraction(span.Duration);
+				if (span.Slot != 0 || span.Group >= 0)
+				{
+					aStream << ",\"args\":{";
+					if (span.Slot != 0)
+						aStream << "\"slot\":" << span.Slot << (span.Group >= 0 ? "," : "");
+					if (span.Group >= 0)
+						aStream << "\"group\":" << span.Group;
+					aStream << "}";
+				}
+				aStream << "}";
+			}
+			Buffer->Read.store(Write, std::memory_order_release);
+		}
+		aStream << "\n]}\n";
+		Buffers.swap(Active);
+	}
+
+	bool Flush(const std::string & aPath)
+	{ // Writes the trace to a file, returns false when it could not be written
+		std::ofstream Stream(aPath, std::ios::out | std::ios::trunc);
+		if (!Stream)
+			return false;
+		Flush(Stream);
+		return static_cast<bool>(Stream);
+	}
+
+	std::uint64_t GetDroppedCount() const
+	{ // Returns how many spans were dropped because a buffer was full
+		std::lock_guard<std::mutex> Lock(TracerMutex);
+		std::uint64_t               Dropped = FinishedDropped;
+		for (const std::shared_ptr<ThreadBuffer> & Buffer : Buffers)
+			Dropped += Buffer->Dropped.load(std::memory_order_relaxed);
+		return Dropped;
+	}
+
+private:
+	Tracer() = default;
+
+	ThreadBuffer & GetThreadBuffer()
+	{ // The first span of a thread registers its buffer
+		thread_local ThreadHandle Handle;
+		if (!Handle.Buffer)
+		{
+			Handle.Buffer = std::make_shared<ThreadBuffer>();
+			Handle.Buffer->Spans.resize(BufferCapacity);
+
+			std::lock_guard<std::mutex> Lock(TracerMutex);
+			Handle.Buffer->Thread = NextThread++;
+			Buffers.push_back(Handle.Buffer);
+		}
+		return *Handle.Buffer;
+	}
+
+	static std::uint64_t Nanoseconds(Clock::duration aDuration)
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(aDuration).count());
+	}
+
+	static std::string Fraction(std::uint64_t aNanoseconds)
+	{ // Chrome traces use microseconds, the remaining nanoseconds are written as three decimals
+		const unsigned Rest = static_cast<unsigned>(aNanoseconds % 1000);
+		return std::string(1, char('0' + Rest / 100)) + char('0' + Rest / 10 % 10) + char('0' + Rest % 10);
+	}
+
+	static void WriteString(std::ostream & aStream, const char * aText)
+	{
+		aStream << '"';
+		for (const char * c = aText; *c != '\0'; c++)
+		{
+			if (*c == '"' || *c == '\\')
+				aStream << '\\' << *c;
+			else if (static_cast<unsigned char>(*c) < 0x20)
+				aStream << ' ';
+			else
+				aStream << *c;
+		}
+		aStream << '"';
+	}
+
+private:
+	const Clock::time_point                    Epoch = Clock::now();
+	std::vector<std::shared_ptr<ThreadBuffer>> Buffers;
+	std::uint64_t                              NextThread      = 1;
+	std::uint64_t                              FinishedDropped = 0; // Dropped by threads whose buffer is gone
+	std::unordered_set<std::string>            Names;
+	mutable std::mutex                         TracerMutex;
+};
+
+// Records the time between its construction and destruction as a span, when tracing was enabled at construction
+class TraceSpan
+{
+public:
+	TraceSpan(const char * aCategory, const char * aName, std::uint64_t aSlot = 0, std::int64_t aGroup = -1)
+	    : TraceSpan(Tracer::Enabled(), aCategory, aName, aSlot, aGroup)
+	{
+	}
+
+	TraceSpan(bool aActive, const char * aCategory, const char * aName, std::uint64_t aSlot = 0,
+	          std::int64_t aGroup = -1)
+	    : Active(aActive)
+	{
+		if (Active)
+		{
+			Category = aCategory;
+			Name     = aName;
+			Slot     = aSlot;
+			Group    = aGroup;
+			Begin    = std::chrono::steady_clock::now();
+		}
+	}
+
+	TraceSpan(const TraceSpan &) = delete;
+
+	~TraceSpan()
+	{
+		if (Active)
+			Tracer::Shared().Record(Category, Name, Begin, std::chrono::steady_clock::now(), Slot, Group);
+	}
+
+	bool IsActive() const
+	{
+		return Active;
+	}
+
+private:
+	const bool                            Active;
+	const char *                          Category = nullptr;
+	const char *                          Name     = nullptr;
+	std::uint64_t                         Slot     = 0;
+	std::int64_t                          Group    = -1;
+	std::chrono::steady_clock::time_point Begin;
+};
+
+} // namespace el
+
+#endif // EL_DISABLE_TRACING